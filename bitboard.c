@@ -0,0 +1,175 @@
+#include <string.h>  // memcpy, usado na geração das placas grandes
+#include "bitboard.h"
+
+// Índice na fita de cada bit do bitboard (o mesmo que indiceLED, em tabela)
+static const uint8_t mapa_led[NLEDS] = {
+     4,  3,  2,  1,  0,
+     5,  6,  7,  8,  9,
+    14, 13, 12, 11, 10,
+    15, 16, 17, 18, 19,
+    24, 23, 22, 21, 20
+};
+
+// Diagonais x - y = d, de d = -4 a d = 4, usadas na transposição
+static const bitboard_t diagonais[9] = {
+    0x0100000, 0x0208000, 0x0410400, 0x0820820, 0x1041041,
+    0x0082082, 0x0004104, 0x0000208, 0x0000010
+};
+
+uint8_t bb_conta(bitboard_t b) {
+    b = b - ((b >> 1) & 0x55555555);
+    b = (b & 0x33333333) + ((b >> 2) & 0x33333333);
+    b = (b + (b >> 4)) & 0x0F0F0F0F;
+    return (b * 0x01010101) >> 24;
+}
+
+bitboard_t bb_espelha_horizontal(bitboard_t b) {
+    return ((b & BB_COLUNA_0) << 4) | ((b & (BB_COLUNA_0 << 1)) << 2) | (b & (BB_COLUNA_0 << 2))
+         | ((b & (BB_COLUNA_0 << 3)) >> 2) | ((b & BB_COLUNA_4) >> 4);
+}
+
+bitboard_t bb_espelha_vertical(bitboard_t b) {
+    return ((b & BB_LINHA_0) << 20) | ((b & (BB_LINHA_0 << 5)) << 10) | (b & (BB_LINHA_0 << 10))
+         | ((b & (BB_LINHA_0 << 15)) >> 10) | ((b & BB_LINHA_4) >> 20);
+}
+
+bitboard_t bb_rotaciona(bitboard_t b) {
+    bitboard_t t = b & diagonais[4];
+
+    // Transposição: o pixel (x, y) vai para (y, x), um deslocamento de 4 * (x - y) bits
+    for (int d = 1; d <= 4; d++) {
+        t |= (b & diagonais[4 + d]) << (4 * d);
+        t |= (b & diagonais[4 - d]) >> (4 * d);
+    }
+
+    // Transpor e espelhar na vertical equivale a girar 90 graus no sentido horário
+    return bb_espelha_vertical(t);
+}
+
+/**
+ * Soma bit a bit os vizinhos em um contador de 4 bits por pixel (c0 a c3) e
+ * aplica a regra a todos os pixels de uma vez.
+ */
+static uint32_t aplicaRegra(uint32_t atual, const uint32_t vizinhos[8], bb_regra_t regra) {
+    uint32_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+
+    for (int i = 0; i < 8; i++) {
+        uint32_t n = vizinhos[i];
+        uint32_t v0 = c0 & n;
+        c0 ^= n;
+        uint32_t v1 = c1 & v0;
+        c1 ^= v0;
+        uint32_t v2 = c2 & v1;
+        c2 ^= v1;
+        c3 |= v2;
+    }
+
+    uint32_t proximo = 0;
+    for (int k = 0; k <= 8; k++) {
+        if (!(((regra.nasce | regra.sobrevive) >> k) & 1)) continue;
+
+        uint32_t igual = ((k & 1) ? c0 : ~c0) & ((k & 2) ? c1 : ~c1)
+                       & ((k & 4) ? c2 : ~c2) & ((k & 8) ? c3 : ~c3);
+        if ((regra.nasce >> k) & 1) proximo |= igual & ~atual;
+        if ((regra.sobrevive >> k) & 1) proximo |= igual & atual;
+    }
+    return proximo;
+}
+
+bitboard_t bb_passo(bitboard_t b, bb_regra_t regra, bool toroide) {
+    uint32_t vizinhos[8];
+
+    if (toroide) {
+        bitboard_t d = bb_rola_direita(b), e = bb_rola_esquerda(b);
+        vizinhos[0] = d;
+        vizinhos[1] = e;
+        vizinhos[2] = bb_rola_cima(b);
+        vizinhos[3] = bb_rola_baixo(b);
+        vizinhos[4] = bb_rola_cima(d);
+        vizinhos[5] = bb_rola_cima(e);
+        vizinhos[6] = bb_rola_baixo(d);
+        vizinhos[7] = bb_rola_baixo(e);
+    } else {
+        bitboard_t d = bb_direita(b), e = bb_esquerda(b);
+        vizinhos[0] = d;
+        vizinhos[1] = e;
+        vizinhos[2] = bb_cima(b);
+        vizinhos[3] = bb_baixo(b);
+        vizinhos[4] = bb_cima(d);
+        vizinhos[5] = bb_cima(e);
+        vizinhos[6] = bb_baixo(d);
+        vizinhos[7] = bb_baixo(e);
+    }
+    return aplicaRegra(b, vizinhos, regra) & BB_TUDO;
+}
+
+void bb_pinta(bitboard_t b, uint32_t cor, uint32_t fita[NLEDS]) {
+    b &= BB_TUDO;
+    // Percorre só os bits acesos, do menos para o mais significativo
+    while (b) {
+        fita[mapa_led[__builtin_ctz(b)]] = cor;
+        b &= b - 1;
+    }
+}
+
+static inline uint32_t mascaraLargura(uint8_t largura) {
+    return largura >= 32 ? 0xFFFFFFFFu : (1u << largura) - 1;
+}
+
+void bbg_inicia(bb_grande_t *g, uint8_t largura, uint8_t altura) {
+    memset(g, 0, sizeof(*g));
+    g->largura = largura > 32 ? 32 : largura;
+    g->altura = altura > BBG_MAX_LINHAS ? BBG_MAX_LINHAS : altura;
+}
+
+uint16_t bbg_conta(const bb_grande_t *g) {
+    uint16_t total = 0;
+    for (uint8_t y = 0; y < g->altura; y++) {
+        total += bb_conta(g->linhas[y]);
+    }
+    return total;
+}
+
+void bbg_passo(bb_grande_t *g, bb_regra_t regra, bool toroide) {
+    uint32_t novas[BBG_MAX_LINHAS];
+    uint32_t vizinhos[8];
+    uint32_t mascara = mascaraLargura(g->largura);
+    uint8_t w = g->largura;
+
+    for (uint8_t y = 0; y < g->altura; y++) {
+        uint32_t linhas[3];  // Abaixo, atual e acima
+
+        for (int k = 0; k < 3; k++) {
+            int yy = y + k - 1;
+            if (yy < 0 || yy >= g->altura) {
+                yy = toroide ? (yy + g->altura) % g->altura : -1;
+            }
+            linhas[k] = yy < 0 ? 0 : g->linhas[yy];
+        }
+
+        // Cada linha vizinha contribui deslocada para a direita, sem deslocamento e para a esquerda
+        int n = 0;
+        for (int k = 0; k < 3; k++) {
+            uint32_t l = linhas[k];
+            uint32_t dir = (l << 1) & mascara;
+            uint32_t esq = l >> 1;
+            if (toroide) {
+                dir |= l >> (w - 1);
+                esq |= (l << (w - 1)) & mascara;
+            }
+            vizinhos[n++] = dir;
+            vizinhos[n++] = esq;
+            if (k != 1) vizinhos[n++] = l;
+        }
+        novas[y] = aplicaRegra(linhas[1], vizinhos, regra) & mascara;
+    }
+    memcpy(g->linhas, novas, g->altura * sizeof(uint32_t));
+}
+
+bitboard_t bbg_recorta(const bb_grande_t *g, uint8_t x0, uint8_t y0) {
+    bitboard_t b = 0;
+    for (uint8_t y = 0; y < HEIGHT && y0 + y < g->altura; y++) {
+        b |= ((g->linhas[y0 + y] >> x0) & BB_LINHA_0) << (y * WIDTH);
+    }
+    return b;
+}
@@ -0,0 +1,110 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "matriz.h"
+
+/**
+ * Camada monocromática da matriz em um único uint32_t: o bit (y * WIDTH + x)
+ * indica se o pixel (x, y) está aceso, com x da esquerda para a direita e y
+ * de baixo para cima. Todas as operações tratam a matriz inteira de uma vez.
+ */
+typedef uint32_t bitboard_t;
+
+#define BB_TUDO ((bitboard_t)((1u << NLEDS) - 1))
+#define BB_COLUNA_0 ((bitboard_t)0x0108421)               // x = 0 em todas as linhas
+#define BB_COLUNA_4 ((bitboard_t)(BB_COLUNA_0 << (WIDTH - 1)))
+#define BB_LINHA_0 ((bitboard_t)((1u << WIDTH) - 1))       // y = 0 em todas as colunas
+#define BB_LINHA_4 ((bitboard_t)(BB_LINHA_0 << (WIDTH * (HEIGHT - 1))))
+
+/**
+ * Monta um bitboard a partir das 5 linhas escritas como aparecem na matriz,
+ * de cima para baixo, com o pixel x = 0 à esquerda de cada literal:
+ *   BB_LINHAS(0b11111,
+ *             0b10001,
+ *             0b10001,
+ *             0b10001,
+ *             0b11111)
+ */
+#define BB_LINHA_VISUAL(l) ((bitboard_t)((((l) >> 4) & 1) | (((l) >> 2) & 2) | ((l) & 4) \
+                                       | (((l) << 2) & 8) | (((l) << 4) & 16)))
+#define BB_LINHAS(l4, l3, l2, l1, l0) \
+    (BB_LINHA_VISUAL(l0) | (BB_LINHA_VISUAL(l1) << WIDTH) | (BB_LINHA_VISUAL(l2) << (2 * WIDTH)) \
+     | (BB_LINHA_VISUAL(l3) << (3 * WIDTH)) | (BB_LINHA_VISUAL(l4) << (4 * WIDTH)))
+
+// Regra de autômato celular: bit k de 'nasce'/'sobrevive' vale para k vizinhos vivos
+typedef struct {
+    uint16_t nasce;
+    uint16_t sobrevive;
+} bb_regra_t;
+
+#define BB_REGRA_VIDA     ((bb_regra_t){ 1u << 3, (1u << 2) | (1u << 3) })             // B3/S23
+#define BB_REGRA_HIGHLIFE ((bb_regra_t){ (1u << 3) | (1u << 6), (1u << 2) | (1u << 3) }) // B36/S23
+#define BB_REGRA_SEMENTES ((bb_regra_t){ 1u << 2, 0 })                                  // B2/S
+
+static inline bitboard_t bb_pixel(uint8_t x, uint8_t y) {
+    return (bitboard_t)1 << (y * WIDTH + x);
+}
+
+static inline bool bb_aceso(bitboard_t b, uint8_t x, uint8_t y) {
+    return (b >> (y * WIDTH + x)) & 1;
+}
+
+static inline bitboard_t bb_inverte(bitboard_t b) {
+    return ~b & BB_TUDO;
+}
+
+// Deslocamentos de uma casa; os pixels que saem da matriz são descartados
+static inline bitboard_t bb_direita(bitboard_t b)  { return (b & ~BB_COLUNA_4) << 1; }
+static inline bitboard_t bb_esquerda(bitboard_t b) { return (b & ~BB_COLUNA_0) >> 1; }
+static inline bitboard_t bb_cima(bitboard_t b)     { return (b << WIDTH) & BB_TUDO; }
+static inline bitboard_t bb_baixo(bitboard_t b)    { return b >> WIDTH; }
+
+// Deslocamentos circulares: o que sai por um lado entra pelo outro
+static inline bitboard_t bb_rola_direita(bitboard_t b) {
+    return ((b & ~BB_COLUNA_4) << 1) | ((b & BB_COLUNA_4) >> (WIDTH - 1));
+}
+static inline bitboard_t bb_rola_esquerda(bitboard_t b) {
+    return ((b & ~BB_COLUNA_0) >> 1) | ((b & BB_COLUNA_0) << (WIDTH - 1));
+}
+static inline bitboard_t bb_rola_cima(bitboard_t b) {
+    return ((b << WIDTH) & BB_TUDO) | (b >> (WIDTH * (HEIGHT - 1)));
+}
+static inline bitboard_t bb_rola_baixo(bitboard_t b) {
+    return (b >> WIDTH) | ((b & BB_LINHA_0) << (WIDTH * (HEIGHT - 1)));
+}
+
+// Quantidade de pixels acesos
+uint8_t bb_conta(bitboard_t b);
+
+// Espelhamentos (esquerda-direita e cima-baixo) e rotação de 90 graus no sentido horário
+bitboard_t bb_espelha_horizontal(bitboard_t b);
+bitboard_t bb_espelha_vertical(bitboard_t b);
+bitboard_t bb_rotaciona(bitboard_t b);
+
+// Uma geração do autômato celular; com 'toroide' as bordas opostas são vizinhas
+bitboard_t bb_passo(bitboard_t b, bb_regra_t regra, bool toroide);
+
+// Pinta com 'cor' os LEDs acesos no bitboard, sem alterar os demais
+void bb_pinta(bitboard_t b, uint32_t cor, uint32_t fita[NLEDS]);
+
+/**
+ * Versão em várias palavras para painéis maiores: uma palavra por linha,
+ * com até 32 colunas e BBG_MAX_LINHAS linhas, na mesma orientação.
+ */
+#define BBG_MAX_LINHAS 32
+
+typedef struct {
+    uint8_t largura, altura;
+    uint32_t linhas[BBG_MAX_LINHAS];
+} bb_grande_t;
+
+void bbg_inicia(bb_grande_t *g, uint8_t largura, uint8_t altura);
+uint16_t bbg_conta(const bb_grande_t *g);
+void bbg_passo(bb_grande_t *g, bb_regra_t regra, bool toroide);
+
+// Copia para um bitboard 5x5 o trecho cujo canto inferior esquerdo é (x0, y0)
+bitboard_t bbg_recorta(const bb_grande_t *g, uint8_t x0, uint8_t y0);
+
+#endif
@@ -0,0 +1,101 @@
+#include <string.h>  // memmove e memset, usados para deslocar o corpo e limpar a fita
+#include "cobra.h"
+
+// Gerador xorshift32, para sortear a comida sem depender de rand()
+static uint32_t sorteia(cobra_jogo_t *jogo) {
+    uint32_t x = jogo->semente;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    jogo->semente = x;
+    return x;
+}
+
+// Sorteia uma das casas livres para a comida; encerra o jogo se não houver nenhuma
+static void posicionaComida(cobra_jogo_t *jogo) {
+    uint8_t livres = NLEDS - jogo->tamanho;
+    if (!livres) {
+        jogo->fim = true;
+        return;
+    }
+
+    // Descarta as casas livres anteriores à sorteada e fica com a primeira que sobrar
+    bitboard_t livre = bb_inverte(jogo->ocupadas);
+    for (uint8_t alvo = sorteia(jogo) % livres; alvo; alvo--) {
+        livre &= livre - 1;
+    }
+    jogo->comida = __builtin_ctz(livre);
+}
+
+void cobra_inicia(cobra_jogo_t *jogo, uint32_t semente) {
+    memset(jogo, 0, sizeof(*jogo));
+    jogo->semente = semente ? semente : 1;
+
+    // Começa na linha do meio, andando para a direita
+    jogo->corpo[0] = 2 * WIDTH + 1;
+    jogo->corpo[1] = 2 * WIDTH + 0;
+    jogo->ocupadas = (1u << jogo->corpo[0]) | (1u << jogo->corpo[1]);
+    jogo->tamanho = 2;
+    jogo->direcao = COBRA_DIREITA;
+    posicionaComida(jogo);
+}
+
+bool cobra_muda_direcao(cobra_jogo_t *jogo, cobra_direcao_t direcao) {
+    // O oposto de cada direção difere apenas no bit menos significativo
+    if (jogo->fim || direcao == jogo->direcao || (direcao ^ 1) == jogo->direcao) {
+        return false;
+    }
+    jogo->direcao = direcao;
+    return true;
+}
+
+void cobra_passo(cobra_jogo_t *jogo) {
+    if (jogo->fim) return;
+
+    int x = jogo->corpo[0] % WIDTH;
+    int y = jogo->corpo[0] / WIDTH;
+    switch (jogo->direcao) {
+        case COBRA_CIMA:     y++; break;
+        case COBRA_BAIXO:    y--; break;
+        case COBRA_ESQUERDA: x--; break;
+        case COBRA_DIREITA:  x++; break;
+    }
+
+    // Colisão com a parede
+    if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) {
+        jogo->fim = true;
+        return;
+    }
+
+    uint8_t cabeca = y * WIDTH + x;
+    bool comeu = (cabeca == jogo->comida);
+
+    // Sem comida a cauda anda junto, então a casa dela pode ser ocupada pela cabeça
+    bitboard_t corpo = jogo->ocupadas;
+    if (!comeu) corpo &= ~(1u << jogo->corpo[jogo->tamanho - 1]);
+    if (corpo & (1u << cabeca)) {
+        jogo->fim = true;
+        return;
+    }
+
+    if (!comeu) jogo->tamanho--;
+    memmove(&jogo->corpo[1], &jogo->corpo[0], jogo->tamanho);
+    jogo->corpo[0] = cabeca;
+    jogo->tamanho++;
+    jogo->ocupadas = corpo | (1u << cabeca);
+
+    if (comeu) {
+        jogo->pontos++;
+        posicionaComida(jogo);
+    }
+}
+
+void cobra_renderiza(const cobra_jogo_t *jogo, uint32_t fita[NLEDS]) {
+    memset(fita, 0, NLEDS * sizeof(uint32_t));
+
+    if (jogo->tamanho < NLEDS) {
+        fita[indiceLED(jogo->comida % WIDTH, jogo->comida / WIDTH)] = urgb_u32(128, 0, 0);
+    }
+    bb_pinta(jogo->ocupadas & ~(1u << jogo->corpo[0]), urgb_u32(0, 128, 0), fita);
+    fita[indiceLED(jogo->corpo[0] % WIDTH, jogo->corpo[0] / WIDTH)] = urgb_u32(128, 128, 0);
+}
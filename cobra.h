@@ -0,0 +1,51 @@
+#ifndef COBRA_H
+#define COBRA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "matriz.h"
+#include "bitboard.h"
+
+// Direções de movimento da cobra
+typedef enum {
+    COBRA_CIMA,
+    COBRA_BAIXO,
+    COBRA_ESQUERDA,
+    COBRA_DIREITA
+} cobra_direcao_t;
+
+/**
+ * Estado do jogo da cobra.
+ *
+ * corpo = Posições lógicas (y * WIDTH + x) dos segmentos; corpo[0] é a cabeça.
+ * ocupadas = As mesmas posições como bitboard, para testar colisões de uma vez.
+ * tamanho = Quantidade de segmentos em uso.
+ * direcao = Direção do último movimento realizado.
+ * comida = Posição lógica da comida.
+ * pontos = Quantidade de comidas já engolidas.
+ * fim = Verdadeiro quando a cobra bate na parede, em si mesma ou enche a matriz.
+ */
+typedef struct {
+    uint8_t corpo[NLEDS];
+    bitboard_t ocupadas;
+    uint8_t tamanho;
+    uint8_t direcao;
+    uint8_t comida;
+    uint16_t pontos;
+    bool fim;
+    uint32_t semente;
+} cobra_jogo_t;
+
+// Coloca a cobra no início, com 2 segmentos, e sorteia a primeira comida
+void cobra_inicia(cobra_jogo_t *jogo, uint32_t semente);
+
+// Troca a direção; retorna falso se ela for igual à atual ou o oposto dela
+bool cobra_muda_direcao(cobra_jogo_t *jogo, cobra_direcao_t direcao);
+
+// Avança a cobra uma casa na direção atual, tratando comida e colisões
+void cobra_passo(cobra_jogo_t *jogo);
+
+// Desenha a cobra e a comida no buffer da fita
+void cobra_renderiza(const cobra_jogo_t *jogo, uint32_t fita[NLEDS]);
+
+#endif
@@ -0,0 +1,123 @@
+#include <stdio.h>  // printf, usado no relatório
+#include "governador.h"  // governador_remove_sm, para esquecer o divisor da máquina liberada
+#include "gerenciador_pio.h"
+
+#define INSTRUCOES_PIO 32
+
+// Programa carregado em um bloco PIO e quantas máquinas de estado o usam
+typedef struct {
+    const pio_program_t *programa;
+    const char *nome;
+    uint offset;
+    uint8_t usos;
+} programa_carregado_t;
+
+// Estado de um bloco PIO
+typedef struct {
+    programa_carregado_t programas[GERENCIADOR_MAX_PROGRAMAS];
+    uint32_t instrucoes;       // Bit i = instrução i ocupada
+    const char *donos[NUM_PIO_STATE_MACHINES];  // Nome do programa em cada máquina de estado
+} bloco_pio_t;
+
+static bloco_pio_t blocos[NUM_PIOS];
+
+static programa_carregado_t *procura(bloco_pio_t *bloco, const pio_program_t *programa) {
+    for (int i = 0; i < GERENCIADOR_MAX_PROGRAMAS; i++) {
+        if (bloco->programas[i].programa == programa) return &bloco->programas[i];
+    }
+    return NULL;
+}
+
+// Instruções ocupadas pelo programa; um programa de 32 instruções ocupa a memória inteira
+static uint32_t mascaraPrograma(const pio_program_t *programa, uint offset) {
+    uint32_t mascara = programa->length >= INSTRUCOES_PIO ? ~0u : (1u << programa->length) - 1;
+    return mascara << offset;
+}
+
+// Reserva uma máquina de estado no bloco, carregando o programa se preciso
+static bool alocaNoBloco(uint indice, const pio_program_t *programa, const char *nome,
+                         bool so_compartilhado, pio_recurso_t *recurso) {
+    PIO pio = pio_get_instance(indice);
+    bloco_pio_t *bloco = &blocos[indice];
+    programa_carregado_t *carregado = procura(bloco, programa);
+
+    if (!carregado) {
+        if (so_compartilhado) return false;
+        carregado = procura(bloco, NULL);
+        if (!carregado || !pio_can_add_program(pio, programa)) return false;
+    }
+
+    int sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0) return false;
+
+    if (!carregado->programa) {
+        carregado->offset = pio_add_program(pio, programa);
+        carregado->programa = programa;
+        carregado->nome = nome;
+        carregado->usos = 0;
+        bloco->instrucoes |= mascaraPrograma(programa, carregado->offset);
+    }
+    carregado->usos++;
+    bloco->donos[sm] = carregado->nome;
+
+    recurso->pio = pio;
+    recurso->sm = sm;
+    recurso->offset = carregado->offset;
+    recurso->programa = programa;
+    return true;
+}
+
+bool gerenciador_aloca(const pio_program_t *programa, const char *nome, pio_recurso_t *recurso) {
+    // Primeiro tenta reaproveitar uma cópia já carregada, depois carrega uma nova
+    for (uint i = 0; i < NUM_PIOS; i++) {
+        if (alocaNoBloco(i, programa, nome, true, recurso)) return true;
+    }
+    for (uint i = 0; i < NUM_PIOS; i++) {
+        if (alocaNoBloco(i, programa, nome, false, recurso)) return true;
+    }
+    return false;
+}
+
+void gerenciador_libera(pio_recurso_t *recurso) {
+    uint indice = pio_get_index(recurso->pio);
+    bloco_pio_t *bloco = &blocos[indice];
+    programa_carregado_t *carregado = procura(bloco, recurso->programa);
+
+    pio_sm_set_enabled(recurso->pio, recurso->sm, false);
+    governador_remove_sm(recurso->pio, recurso->sm);
+    pio_sm_unclaim(recurso->pio, recurso->sm);
+    bloco->donos[recurso->sm] = NULL;
+
+    if (carregado && --carregado->usos == 0) {
+        pio_remove_program(recurso->pio, carregado->programa, carregado->offset);
+        bloco->instrucoes &= ~mascaraPrograma(carregado->programa, carregado->offset);
+        carregado->programa = NULL;
+    }
+    recurso->programa = NULL;
+}
+
+void gerenciador_relatorio(void) {
+    for (uint i = 0; i < NUM_PIOS; i++) {
+        bloco_pio_t *bloco = &blocos[i];
+        char mapa[INSTRUCOES_PIO + 1];
+        int livres = 0;
+
+        for (int k = 0; k < INSTRUCOES_PIO; k++) {
+            bool ocupada = (bloco->instrucoes >> k) & 1;
+            mapa[k] = ocupada ? '#' : '.';
+            livres += !ocupada;
+        }
+        mapa[INSTRUCOES_PIO] = '\0';
+
+        printf("PIO%u: instrucoes [%s] %d livres\n", i, mapa, livres);
+        for (int k = 0; k < GERENCIADOR_MAX_PROGRAMAS; k++) {
+            const programa_carregado_t *p = &bloco->programas[k];
+            if (!p->programa) continue;
+            printf("  %s: offset %u, %u instrucoes, %u maquinas\n",
+                   p->nome, p->offset, p->programa->length, p->usos);
+        }
+        for (int sm = 0; sm < NUM_PIO_STATE_MACHINES; sm++) {
+            printf("  SM%d: %s\n", sm, bloco->donos[sm] ? bloco->donos[sm] : "livre");
+        }
+    }
+}
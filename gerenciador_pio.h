@@ -0,0 +1,40 @@
+#ifndef GERENCIADOR_PIO_H
+#define GERENCIADOR_PIO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware/pio.h"
+
+// Quantidade máxima de programas diferentes carregados em cada bloco PIO
+#define GERENCIADOR_MAX_PROGRAMAS 8
+
+/**
+ * Máquina de estado entregue pelo gerenciador.
+ *
+ * pio, sm = Bloco PIO e máquina de estado reservados.
+ * offset = Posição do programa na memória de instruções do bloco.
+ * programa = Programa carregado para esta máquina de estado.
+ */
+typedef struct {
+    PIO pio;
+    uint sm;
+    uint offset;
+    const pio_program_t *programa;
+} pio_recurso_t;
+
+/**
+ * Reserva uma máquina de estado para rodar 'programa' em qualquer um dos
+ * blocos PIO. Se o programa já estiver carregado em um bloco com máquina
+ * livre, a cópia é compartilhada; senão ele é carregado onde houver espaço.
+ * 'nome' aparece no relatório de ocupação. Retorna falso se não houver
+ * máquina de estado ou memória de instruções disponível.
+ */
+bool gerenciador_aloca(const pio_program_t *programa, const char *nome, pio_recurso_t *recurso);
+
+// Desliga e devolve a máquina de estado; o programa é descarregado quando ninguém mais o usa
+void gerenciador_libera(pio_recurso_t *recurso);
+
+// Imprime a ocupação da memória de instruções e das máquinas de estado de cada bloco
+void gerenciador_relatorio(void);
+
+#endif
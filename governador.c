@@ -0,0 +1,111 @@
+#include "pico/stdlib.h"  // set_sys_clock_pll e check_sys_clock_khz
+#include "hardware/clocks.h"  // clock_get_hz, usado no cálculo dos divisores
+#include "hardware/sync.h"  // save_and_disable_interrupts, para a troca atômica
+#include "hardware/uart.h"  // uart_set_baudrate, para refazer o baud dos UARTs
+#include "governador.h"
+
+// Máquina de estado cujo clock deve ser mantido constante
+typedef struct {
+    PIO pio;
+    uint sm;
+    float hz_alvo;
+} sm_governada_t;
+
+// UART cujo baud deve ser mantido
+typedef struct {
+    uart_inst_t *uart;
+    uint baud;
+} uart_governado_t;
+
+static sm_governada_t sms[GOVERNADOR_MAX_SM];
+static uint8_t num_sms;
+static uart_governado_t uarts[GOVERNADOR_MAX_UART];
+static uint8_t num_uarts;
+static void (*aguarda)(void);
+
+void governador_inicia(void (*aguarda_quadro)(void)) {
+    aguarda = aguarda_quadro;
+    num_sms = 0;
+    num_uarts = 0;
+#if LIB_PICO_STDIO_UART
+    governador_registra_uart(uart_default, PICO_DEFAULT_UART_BAUD_RATE);
+#endif
+}
+
+static void aplicaDivisor(const sm_governada_t *s) {
+    pio_sm_set_clkdiv(s->pio, s->sm, clock_get_hz(clk_sys) / s->hz_alvo);
+    pio_sm_clkdiv_restart(s->pio, s->sm);
+}
+
+bool governador_registra_sm(PIO pio, uint sm, float hz_alvo) {
+    for (uint8_t i = 0; i < num_sms; i++) {
+        if (sms[i].pio == pio && sms[i].sm == sm) {
+            sms[i].hz_alvo = hz_alvo;
+            return true;
+        }
+    }
+    if (num_sms == GOVERNADOR_MAX_SM) return false;
+
+    sms[num_sms] = (sm_governada_t){ pio, sm, hz_alvo };
+    aplicaDivisor(&sms[num_sms]);
+    num_sms++;
+    return true;
+}
+
+void governador_remove_sm(PIO pio, uint sm) {
+    for (uint8_t i = 0; i < num_sms; i++) {
+        if (sms[i].pio == pio && sms[i].sm == sm) {
+            sms[i] = sms[--num_sms];
+            return;
+        }
+    }
+}
+
+bool governador_registra_uart(uart_inst_t *uart, uint baud) {
+    for (uint8_t i = 0; i < num_uarts; i++) {
+        if (uarts[i].uart == uart) {
+            uarts[i].baud = baud;
+            return true;
+        }
+    }
+    if (num_uarts == GOVERNADOR_MAX_UART) return false;
+
+    uarts[num_uarts++] = (uart_governado_t){ uart, baud };
+    return true;
+}
+
+bool governador_define_khz(uint32_t khz) {
+    uint vco, div1, div2;
+
+    if (khz == governador_khz()) return true;
+    if (!check_sys_clock_khz(khz, &vco, &div1, &div2)) return false;
+
+    // Só troca entre quadros, para não deformar os bits que estão saindo para a fita
+    if (aguarda) aguarda();
+
+    // Clock e divisores mudam juntos. O temporizador usa o XOSC, então sleep_us
+    // e a temporização dos tons em emiteSom não dependem do clk_sys
+    uint32_t estado = save_and_disable_interrupts();
+    set_sys_clock_pll(vco, div1, div2);
+    for (uint8_t i = 0; i < num_sms; i++) {
+        aplicaDivisor(&sms[i]);
+    }
+    // set_sys_clock_pll move o clk_peri para o PLL USB (48 MHz), então o baud dos UARTs é refeito
+    for (uint8_t i = 0; i < num_uarts; i++) {
+        uart_set_baudrate(uarts[i].uart, uarts[i].baud);
+    }
+    restore_interrupts(estado);
+    return true;
+}
+
+uint32_t governador_khz(void) {
+    return clock_get_hz(clk_sys) / 1000;
+}
+
+void governador_desempenho(void) {
+    governador_define_khz(GOVERNADOR_KHZ_DESEMPENHO);
+}
+
+void governador_economia(void) {
+    governador_define_khz(GOVERNADOR_KHZ_ECONOMIA);
+}
@@ -0,0 +1,50 @@
+#ifndef GOVERNADOR_H
+#define GOVERNADOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware/pio.h"
+#include "hardware/uart.h"
+
+// Frequências do clk_sys usadas pelo governador (precisam ser válidas para check_sys_clock_khz)
+#define GOVERNADOR_KHZ_DESEMPENHO 133000
+#define GOVERNADOR_KHZ_ECONOMIA 48000
+
+// Tempo sem atividade até o governador baixar o clock
+#define GOVERNADOR_OCIOSO_MS 2000
+
+// Quantidade máxima de máquinas de estado PIO e de UARTs acompanhados
+#define GOVERNADOR_MAX_SM 8
+#define GOVERNADOR_MAX_UART 2
+
+/**
+ * Prepara o governador.
+ *
+ * aguarda_quadro = Função que bloqueia até o último quadro terminar de ser
+ * enviado, chamada antes de cada troca de clock (pode ser NULL).
+ */
+void governador_inicia(void (*aguarda_quadro)(void));
+
+/**
+ * Passa a recalcular o divisor da máquina de estado a cada troca de clock,
+ * mantendo o clock dela em 'hz_alvo' (ex.: 800 kHz * ciclos por bit no WS2812).
+ */
+bool governador_registra_sm(PIO pio, uint sm, float hz_alvo);
+
+// Deixa de acompanhar a máquina de estado
+void governador_remove_sm(PIO pio, uint sm);
+
+// Refaz o baud do UART após cada troca de clock (o stdio UART é registrado automaticamente)
+bool governador_registra_uart(uart_inst_t *uart, uint baud);
+
+// Troca o clk_sys entre quadros e atualiza todos os divisores; retorna falso se a frequência for inválida
+bool governador_define_khz(uint32_t khz);
+
+// Frequência atual do clk_sys, em kHz
+uint32_t governador_khz(void);
+
+// Atalhos para os dois níveis usados pelo programa
+void governador_desempenho(void);
+void governador_economia(void);
+
+#endif
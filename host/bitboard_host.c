@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include "bitboard.h"
+
+/**
+ * Confere a versão em várias palavras do bitboard (bb_grande_t) no computador:
+ *  - bbg_passo contra uma implementação célula a célula, em painéis de várias
+ *    larguras (inclusive 32 colunas, em que a borda cai no último bit da palavra),
+ *    com e sem toroide;
+ *  - um planador atravessando as bordas de um painel toroidal 10x10;
+ *  - bbg_recorta + bb_passo (5x5) contra bbg_passo + bbg_recorta, em janelas
+ *    espalhadas pelo painel.
+ * Retorna 1 se algo falhar.
+ */
+
+static uint32_t semente = 2024;
+static int falhas;
+
+// Gerador xorshift32, para a verificação se repetir igual a cada execução
+static uint32_t sorteia(void) {
+    semente ^= semente << 13;
+    semente ^= semente >> 17;
+    semente ^= semente << 5;
+    return semente;
+}
+
+static bool celula(const bb_grande_t *g, int x, int y, bool toroide) {
+    if (toroide) {
+        x = (x + g->largura) % g->largura;
+        y = (y + g->altura) % g->altura;
+    } else if (x < 0 || x >= g->largura || y < 0 || y >= g->altura) {
+        return false;
+    }
+    return (g->linhas[y] >> x) & 1;
+}
+
+// Uma geração calculada vizinho a vizinho, como referência
+static void passoReferencia(const bb_grande_t *g, bb_grande_t *r, bb_regra_t regra, bool toroide) {
+    bbg_inicia(r, g->largura, g->altura);
+    for (int y = 0; y < g->altura; y++) {
+        for (int x = 0; x < g->largura; x++) {
+            int n = 0;
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    if (dx || dy) n += celula(g, x + dx, y + dy, toroide);
+                }
+            }
+            uint16_t regra_celula = celula(g, x, y, false) ? regra.sobrevive : regra.nasce;
+            if ((regra_celula >> n) & 1) r->linhas[y] |= 1u << x;
+        }
+    }
+}
+
+static bool iguais(const bb_grande_t *a, const bb_grande_t *b) {
+    for (int y = 0; y < a->altura; y++) {
+        if (a->linhas[y] != b->linhas[y]) return false;
+    }
+    return true;
+}
+
+static void sorteiaPainel(bb_grande_t *g) {
+    uint32_t mascara = g->largura >= 32 ? 0xFFFFFFFFu : (1u << g->largura) - 1;
+    for (int y = 0; y < g->altura; y++) {
+        g->linhas[y] = sorteia() & sorteia() & mascara;  // Cerca de 1/4 das células vivas
+    }
+}
+
+static void confereReferencia(void) {
+    static const uint8_t tamanhos[][2] = { { 10, 10 }, { 32, 12 }, { 31, 7 }, { 7, 32 }, { 3, 3 } };
+    const bb_regra_t regras[] = { BB_REGRA_VIDA, BB_REGRA_HIGHLIFE, BB_REGRA_SEMENTES };
+    int erros = 0;
+
+    for (int t = 0; t < 5; t++) {
+        for (int r = 0; r < 3; r++) {
+            for (int toroide = 0; toroide <= 1; toroide++) {
+                for (int caso = 0; caso < 50; caso++) {
+                    bb_grande_t g, esperado;
+                    bbg_inicia(&g, tamanhos[t][0], tamanhos[t][1]);
+                    sorteiaPainel(&g);
+
+                    for (int geracao = 0; geracao < 8; geracao++) {
+                        passoReferencia(&g, &esperado, regras[r], toroide);
+                        bbg_passo(&g, regras[r], toroide);
+                        if (!iguais(&g, &esperado)) {
+                            erros++;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    printf("bbg_passo contra a referencia: %d erros\n", erros);
+    falhas += erros != 0;
+}
+
+static void conferePlanador(void) {
+    bb_grande_t g;
+    bbg_inicia(&g, 10, 10);
+
+    // Planador descendo para a direita, a partir do canto superior esquerdo
+    g.linhas[9] = 0b010;
+    g.linhas[8] = 0b100;
+    g.linhas[7] = 0b111;
+    bb_grande_t inicial = g;
+
+    // A cada 4 gerações ele anda uma casa na diagonal; em 40 atravessa as bordas e volta ao início
+    bool ok = true;
+    for (int geracao = 1; geracao <= 40; geracao++) {
+        bbg_passo(&g, BB_REGRA_VIDA, true);
+        if (bbg_conta(&g) != 5) ok = false;
+    }
+    ok = ok && iguais(&g, &inicial);
+    printf("Planador no toroide 10x10: %s\n", ok ? "ok" : "ERRO");
+    falhas += !ok;
+}
+
+static void confereRecorte(void) {
+    static const uint8_t janelas[][2] = { { 0, 0 }, { 13, 4 }, { 27, 7 }, { 5, 0 } };
+    int erros = 0;
+
+    for (int j = 0; j < 4; j++) {
+        uint8_t x0 = janelas[j][0], y0 = janelas[j][1];
+
+        for (int caso = 0; caso < 200; caso++) {
+            // Só a janela tem células vivas, então fora dela tudo é vazio, como no bb_passo sem toroide
+            bb_grande_t g;
+            bbg_inicia(&g, 32, 12);
+            bitboard_t janela = sorteia() & BB_TUDO;
+            for (int y = 0; y < HEIGHT; y++) {
+                g.linhas[y0 + y] = ((janela >> (y * WIDTH)) & BB_LINHA_0) << x0;
+            }
+
+            if (bbg_recorta(&g, x0, y0) != janela || bbg_conta(&g) != bb_conta(janela)) {
+                erros++;
+                continue;
+            }
+            bbg_passo(&g, BB_REGRA_VIDA, false);
+            if (bbg_recorta(&g, x0, y0) != bb_passo(janela, BB_REGRA_VIDA, false)) erros++;
+        }
+    }
+    printf("Recorte 5x5 contra bb_passo: %d erros\n", erros);
+    falhas += erros != 0;
+}
+
+int main(void) {
+    confereReferencia();
+    conferePlanador();
+    confereRecorte();
+
+    printf(falhas ? "FALHOU\n" : "OK\n");
+    return falhas ? 1 : 0;
+}
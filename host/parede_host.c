@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <string.h>
+#include "parede.h"
+
+/**
+ * Simulação da parede no computador: um mestre e quatro placas (painel 2x2)
+ * ligados por um "fio" que inverte bits ao acaso em cada placa. Confere que
+ * toda placa exibe ou conta como perdido cada quadro enviado e que nenhum
+ * quadro exibido difere do que o mestre mandou. Retorna 1 se algo falhar.
+ */
+
+#define COLUNAS 2
+#define LINHAS 2
+#define PLACAS (COLUNAS * LINHAS)
+#define QUADROS 2000
+#define PERIODO_US 40000
+#define ATRASO_US 5000
+#define ERRO_POR_BYTE 3000  // Em média, um bit invertido a cada ERRO_POR_BYTE bytes recebidos
+
+static parede_placa_t placas[PLACAS];
+static uint32_t imagem[LINHAS * HEIGHT][COLUNAS * WIDTH];
+static uint32_t esperado[PLACAS][NLEDS];  // Parte de cada placa no quadro atual, na ordem da fita
+static uint32_t agora_us;
+static uint32_t semente = 12345;
+static unsigned errados;
+
+// Gerador xorshift32, para a simulação se repetir igual a cada execução
+static uint32_t sorteia(void) {
+    semente ^= semente << 13;
+    semente ^= semente >> 17;
+    semente ^= semente << 5;
+    return semente;
+}
+
+// Entrega o pacote a todas as placas; cada uma recebe sua cópia com erros próprios
+static void enviaFio(const uint8_t *dados, size_t tamanho, void *ctx) {
+    bool com_erros = *(bool *)ctx;
+
+    for (int p = 0; p < PLACAS; p++) {
+        for (size_t i = 0; i < tamanho; i++) {
+            uint8_t byte = dados[i];
+            if (com_erros && sorteia() % ERRO_POR_BYTE == 0) {
+                byte ^= 1u << (sorteia() % 8);
+            }
+            parede_placa_recebe(&placas[p], byte, agora_us);
+        }
+    }
+}
+
+static void exibe(const uint32_t fita[NLEDS], void *ctx) {
+    int p = (int)(intptr_t)ctx;
+    if (memcmp(fita, esperado[p], sizeof(esperado[p])) != 0) {
+        errados++;
+    }
+}
+
+// Muda alguns pixels por quadro, para o mestre usar deltas na maior parte do tempo
+static void desenhaQuadro(int q) {
+    for (int k = 0; k < 3; k++) {
+        uint32_t i = sorteia() % (LINHAS * HEIGHT * COLUNAS * WIDTH);
+        imagem[i / (COLUNAS * WIDTH)][i % (COLUNAS * WIDTH)] = urgb_u32(q, q >> 8, sorteia());
+    }
+    for (int p = 0; p < PLACAS; p++) {
+        int bx = p % COLUNAS, by = p / COLUNAS;
+        for (int y = 0; y < HEIGHT; y++) {
+            for (int x = 0; x < WIDTH; x++) {
+                esperado[p][indiceLED(x, y)] = imagem[by * HEIGHT + y][bx * WIDTH + x];
+            }
+        }
+    }
+}
+
+int main(void) {
+    static parede_mestre_t mestre;
+    bool com_erros = false;
+    int falhas = 0;
+
+    parede_mestre_inicia(&mestre, COLUNAS, LINHAS, enviaFio, &com_erros);
+    for (int p = 0; p < PLACAS; p++) {
+        parede_placa_inicia(&placas[p], p, exibe, (void *)(intptr_t)p);
+    }
+
+    for (int q = 0; q < QUADROS; q++) {
+        desenhaQuadro(q);
+        // O primeiro quadro chega limpo: uma placa só começa a contar perdas depois de ver um quadro completo
+        com_erros = q > 0;
+        parede_mestre_envia_quadro(&mestre, &imagem[0][0], ATRASO_US);
+
+        agora_us += ATRASO_US;
+        for (int p = 0; p < PLACAS; p++) {
+            parede_placa_atualiza(&placas[p], agora_us);
+        }
+        agora_us += PERIODO_US - ATRASO_US;
+    }
+
+    parede_mestre_relatorio(&mestre);
+    for (int p = 0; p < PLACAS; p++) {
+        const parede_placa_t *placa = &placas[p];
+        parede_placa_relatorio(placa);
+
+        // Quadro agendado e ainda não exibido no fim da simulação conta como pendente, não como perdido
+        uint32_t total = placa->quadros_exibidos + placa->quadros_perdidos + placa->agendado;
+        if (total != QUADROS) {
+            printf("Placa %d: exibidos + perdidos = %lu, esperado %d\n", p, (unsigned long)total, QUADROS);
+            falhas++;
+        }
+    }
+    if (errados) {
+        printf("%u quadros exibidos diferentes dos enviados\n", errados);
+        falhas++;
+    }
+
+    printf(falhas ? "FALHOU\n" : "OK\n");
+    return falhas ? 1 : 0;
+}
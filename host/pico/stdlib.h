@@ -0,0 +1,24 @@
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+// Substituto mínimo do pico/stdlib.h para compilar os módulos no computador
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#define PICO_ON_DEVICE 0
+
+// Relógio de microssegundos, como o temporizador do RP2040 (estoura a cada ~71 minutos)
+static inline uint32_t time_us_32(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint32_t)(t.tv_sec * 1000000ull + t.tv_nsec / 1000);
+}
+
+static inline void sleep_us(uint64_t us) {
+    struct timespec t = { (time_t)(us / 1000000), (long)(us % 1000000) * 1000 };
+    nanosleep(&t, NULL);
+}
+
+#endif
@@ -0,0 +1,31 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "trace.h"
+
+/**
+ * Grava uma sequência curta de eventos parecida com a do firmware (tecla,
+ * quadro, DMA e espera) e exporta o JSON do Chrome trace na saída padrão:
+ *   ./trace_host > trace.json
+ */
+int main(void) {
+    trace_limpa();
+
+    TRACE(TRACE_TECLA, TRACE_INSTANTE, '5');
+    for (int q = 0; q < 3; q++) {
+        TRACE(TRACE_QUADRO, TRACE_INICIO, q);
+        TRACE(TRACE_DMA, TRACE_INICIO, q);
+        sleep_us(100);
+        TRACE(TRACE_QUADRO, TRACE_FIM, q);
+        sleep_us(650);
+        TRACE(TRACE_DMA, TRACE_FIM, q);
+        TRACE(TRACE_ESPERA, TRACE_INICIO, 20);
+        sleep_us(2000);
+        TRACE(TRACE_ESPERA, TRACE_FIM, 20);
+    }
+    TRACE(TRACE_SOM, TRACE_INICIO, 440);
+    sleep_us(1000);
+    TRACE(TRACE_SOM, TRACE_FIM, 440);
+
+    trace_exporta();
+    return 0;
+}
@@ -0,0 +1,24 @@
+#ifndef MATRIZ_H
+#define MATRIZ_H
+
+#include <stdint.h>
+
+// Dimensões da matriz de LEDs 5x5
+#define NLEDS 25
+#define WIDTH 5
+#define HEIGHT 5
+
+// Função para representar a cor em formato RGB (ordem GRB esperada pelo WS2812)
+static inline uint32_t urgb_u32(uint8_t r, uint8_t g, uint8_t b) {
+    return ((uint32_t)(g) << 24) | ((uint32_t)(r) << 16) | ((uint32_t)(b) << 8);
+}
+
+/**
+ * Converte uma coordenada lógica (x da esquerda para a direita, y de baixo
+ * para cima) no índice do LED na fita, que percorre a matriz em zigue-zague.
+ */
+static inline uint8_t indiceLED(uint8_t x, uint8_t y) {
+    return (y % 2) ? y * WIDTH + x : y * WIDTH + (WIDTH - 1 - x);
+}
+
+#endif
@@ -0,0 +1,51 @@
+#include <stdio.h>   // printf, usado para o relatório
+#include <malloc.h>  // mallinfo, usado para medir o heap
+#include "memoria.h"
+
+// Símbolos definidos pelo script do ligador do SDK (memmap_default.ld)
+extern uint32_t __StackBottom, __StackTop;
+extern char __data_start__, __data_end__;
+extern char __bss_start__, __bss_end__;
+extern char end, __HeapLimit;
+
+// Margem deixada abaixo do ponteiro de pilha atual para não sobrescrever dados vivos
+#define MARGEM_PINTURA 16
+
+void __attribute__((noinline)) memoria_pinta_pilha(void) {
+    volatile uint32_t marcador = 0;
+    uint32_t *p = &__StackBottom;
+    uint32_t *limite = (uint32_t *)&marcador - MARGEM_PINTURA;
+
+    while (p < limite) {
+        *p++ = MEMORIA_PADRAO_PILHA;
+    }
+}
+
+uint32_t memoria_pilha_maxima(void) {
+    const uint32_t *p = &__StackBottom;
+
+    // A pilha cresce para baixo: a primeira palavra alterada marca o ponto mais fundo
+    while (p < &__StackTop && *p == MEMORIA_PADRAO_PILHA) p++;
+    return (uint32_t)((const char *)&__StackTop - (const char *)p);
+}
+
+uint32_t memoria_pilha_total(void) {
+    return (uint32_t)((const char *)&__StackTop - (const char *)&__StackBottom);
+}
+
+void memoria_relatorio(void) {
+    struct mallinfo m = mallinfo();
+    uint32_t pilha_usada = memoria_pilha_maxima();
+    uint32_t pilha_total = memoria_pilha_total();
+    uint32_t dados = (uint32_t)(&__data_end__ - &__data_start__);
+    uint32_t bss = (uint32_t)(&__bss_end__ - &__bss_start__);
+    uint32_t heap_livre = (uint32_t)(&__HeapLimit - &end) - (uint32_t)m.arena;
+
+    printf("Memoria:\n");
+    printf("  Pilha core0: pico de %lu de %lu bytes (%lu%%)\n",
+           (unsigned long)pilha_usada, (unsigned long)pilha_total,
+           (unsigned long)(pilha_total ? pilha_usada * 100 / pilha_total : 0));
+    printf("  .data: %lu bytes, .bss: %lu bytes\n", (unsigned long)dados, (unsigned long)bss);
+    printf("  Heap: %lu bytes em uso, %lu reservados, %lu livres\n",
+           (unsigned long)m.uordblks, (unsigned long)m.arena, (unsigned long)heap_livre);
+}
@@ -0,0 +1,21 @@
+#ifndef MEMORIA_H
+#define MEMORIA_H
+
+#include <stdint.h>
+
+// Padrão escrito na área livre da pilha para medir o quanto dela já foi usado
+#define MEMORIA_PADRAO_PILHA 0xDEADBEEFu
+
+// Preenche a parte ainda não usada da pilha do core0 com o padrão (chamar no início do main)
+void memoria_pinta_pilha(void);
+
+// Maior uso da pilha do core0 desde a pintura, em bytes
+uint32_t memoria_pilha_maxima(void);
+
+// Tamanho total reservado para a pilha do core0, em bytes
+uint32_t memoria_pilha_total(void);
+
+// Imprime no stdio o uso de pilha e de SRAM (dados, bss e heap)
+void memoria_relatorio(void);
+
+#endif
@@ -0,0 +1,244 @@
+#include <stdio.h>   // printf, usado nos relatórios
+#include <string.h>  // memcpy e memset
+#include "parede.h"
+
+// CRC-8 com polinômio 0x07
+static uint8_t crc8(const uint8_t *dados, size_t tamanho) {
+    uint8_t crc = 0;
+    while (tamanho--) {
+        crc ^= *dados++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// Monta um pacote com cabeçalho e CRC e o entrega à função de envio
+static void enviaPacote(parede_mestre_t *m, uint8_t tipo, uint8_t destino,
+                        const uint8_t *dados, uint8_t tamanho) {
+    uint8_t pacote[PAREDE_MAX_PACOTE];
+
+    pacote[0] = PAREDE_INICIO;
+    pacote[1] = tipo;
+    pacote[2] = destino;
+    pacote[3] = (uint8_t)m->quadro;
+    pacote[4] = tamanho;
+    memcpy(&pacote[PAREDE_CABECALHO], dados, tamanho);
+    pacote[PAREDE_CABECALHO + tamanho] = crc8(&pacote[1], PAREDE_CABECALHO - 1 + tamanho);
+
+    m->envia(pacote, PAREDE_CABECALHO + tamanho + 1, m->ctx);
+    m->bytes_enviados += PAREDE_CABECALHO + tamanho + 1;
+}
+
+// Grava uma cor da fita (GRB nos 24 bits superiores) em 3 bytes
+static inline void escreveCor(uint8_t *dst, uint32_t cor) {
+    dst[0] = cor >> 24;
+    dst[1] = cor >> 16;
+    dst[2] = cor >> 8;
+}
+
+static inline uint32_t leCor(const uint8_t *src) {
+    return ((uint32_t)src[0] << 24) | ((uint32_t)src[1] << 16) | ((uint32_t)src[2] << 8);
+}
+
+void parede_mestre_inicia(parede_mestre_t *m, uint8_t colunas, uint8_t linhas,
+                          parede_envia_t envia, void *ctx) {
+    memset(m, 0, sizeof(*m));
+    m->colunas = colunas;
+    m->linhas = linhas;
+    m->envia = envia;
+    m->ctx = ctx;
+}
+
+void parede_mestre_envia_quadro(parede_mestre_t *m, const uint32_t *imagem, uint32_t atraso_us) {
+    uint8_t dados[PAREDE_MAX_DADOS];
+    uint32_t fita[NLEDS];
+    uint16_t largura = m->colunas * WIDTH;
+    uint8_t num_placas = m->colunas * m->linhas;
+    bool completo = (m->quadro % PAREDE_INTERVALO_COMPLETO) == 0;
+
+    if (num_placas > PAREDE_MAX_PLACAS) num_placas = PAREDE_MAX_PLACAS;
+
+    for (uint8_t placa = 0; placa < num_placas; placa++) {
+        uint8_t bx = placa % m->colunas, by = placa / m->colunas;
+
+        // Recorta a parte da imagem que cabe a esta placa, já na ordem da fita
+        for (uint8_t y = 0; y < HEIGHT; y++) {
+            for (uint8_t x = 0; x < WIDTH; x++) {
+                fita[indiceLED(x, y)] = imagem[(by * HEIGHT + y) * largura + bx * WIDTH + x];
+            }
+        }
+
+        uint8_t tamanho = 0;
+        bool usa_completo = completo;
+        if (!usa_completo) {
+            // Só os LEDs alterados; se o delta não for menor que o quadro completo, envia o completo
+            for (uint8_t i = 0; i < NLEDS && !usa_completo; i++) {
+                if (fita[i] == m->anterior[placa][i]) continue;
+                if (tamanho + 4 >= NLEDS * 3) {
+                    usa_completo = true;
+                    break;
+                }
+                dados[tamanho] = i;
+                escreveCor(&dados[tamanho + 1], fita[i]);
+                tamanho += 4;
+            }
+        }
+
+        if (usa_completo) {
+            for (uint8_t i = 0; i < NLEDS; i++) {
+                escreveCor(&dados[i * 3], fita[i]);
+            }
+            enviaPacote(m, PAREDE_COMPLETO, placa, dados, NLEDS * 3);
+            m->pacotes_completos++;
+        } else {
+            // Mesmo sem mudanças o delta vazio é enviado, para a placa saber que o quadro está completo
+            enviaPacote(m, PAREDE_DELTA, placa, dados, tamanho);
+            m->pacotes_delta++;
+        }
+        memcpy(m->anterior[placa], fita, sizeof(fita));
+    }
+
+    // Sincronia em difusão: número do quadro e atraso até a exibição
+    dados[0] = m->quadro & 0xFF;
+    dados[1] = m->quadro >> 8;
+    dados[2] = atraso_us & 0xFF;
+    dados[3] = (atraso_us >> 8) & 0xFF;
+    dados[4] = (atraso_us >> 16) & 0xFF;
+    dados[5] = atraso_us >> 24;
+    enviaPacote(m, PAREDE_SINCRONIA, PAREDE_DIFUSAO, dados, 6);
+
+    m->quadro++;
+}
+
+void parede_placa_inicia(parede_placa_t *p, uint8_t id, parede_exibe_t exibe, void *ctx) {
+    memset(p, 0, sizeof(*p));
+    p->id = id;
+    p->exibe = exibe;
+    p->ctx = ctx;
+    p->atraso_min_us = INT32_MAX;
+    p->atraso_max_us = INT32_MIN;
+}
+
+static void processaPacote(parede_placa_t *p, uint32_t agora_us) {
+    uint8_t tipo = p->pacote[1];
+    uint8_t destino = p->pacote[2];
+    uint8_t quadro = p->pacote[3];
+    uint8_t tamanho = p->pacote[4];
+    const uint8_t *dados = &p->pacote[PAREDE_CABECALHO];
+
+    if (destino != p->id && destino != PAREDE_DIFUSAO) return;
+
+    switch (tipo) {
+        case PAREDE_COMPLETO:
+            if (tamanho != NLEDS * 3) return;
+            for (uint8_t i = 0; i < NLEDS; i++) {
+                p->pendente[i] = leCor(&dados[i * 3]);
+            }
+            p->quadro_pendente = quadro;
+            p->pendente_valido = true;
+            p->sincronizado = true;
+            p->iniciada = true;
+            break;
+
+        case PAREDE_DELTA:
+            if (!p->sincronizado || tamanho % 4) return;
+            // O delta vale apenas sobre o quadro imediatamente anterior; após uma
+            // perda os deltas são ignorados até o próximo quadro completo
+            if (quadro != (uint8_t)(p->quadro_pendente + 1)) {
+                p->sincronizado = false;
+                p->pendente_valido = false;
+                return;
+            }
+            for (uint8_t i = 0; i < tamanho; i += 4) {
+                if (dados[i] < NLEDS) p->pendente[dados[i]] = leCor(&dados[i + 1]);
+            }
+            p->quadro_pendente = quadro;
+            p->pendente_valido = true;
+            break;
+
+        case PAREDE_SINCRONIA: {
+            if (tamanho != 6) return;
+            uint16_t numero = dados[0] | (dados[1] << 8);
+            uint32_t atraso = dados[2] | (dados[3] << 8) | ((uint32_t)dados[4] << 16) | ((uint32_t)dados[5] << 24);
+
+            // As perdas são contadas só aqui, uma por quadro: sincronias que não chegaram,
+            // sincronias sem os dados do quadro e quadros agendados que foram substituídos
+            if (p->contando && numero != (uint16_t)(p->ultima_sincronia + 1)) {
+                p->quadros_perdidos += (uint16_t)(numero - p->ultima_sincronia - 1);
+            }
+            p->ultima_sincronia = numero;
+            p->contando = p->iniciada;
+
+            if (!p->pendente_valido || (uint8_t)numero != p->quadro_pendente) {
+                if (p->iniciada) p->quadros_perdidos++;
+                return;
+            }
+            // Um quadro agendado que ainda não foi exibido é substituído
+            if (p->agendado) p->quadros_perdidos++;
+
+            memcpy(p->agendada, p->pendente, sizeof(p->agendada));
+            p->pendente_valido = false;
+            p->agendado = true;
+            p->instante_exibicao = agora_us + atraso;
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+void parede_placa_recebe(parede_placa_t *p, uint8_t byte, uint32_t agora_us) {
+    if (p->pos == 0 && byte != PAREDE_INICIO) return;
+    p->pacote[p->pos++] = byte;
+    if (p->pos < PAREDE_CABECALHO) return;
+
+    uint8_t tamanho = p->pacote[4];
+    if (tamanho > PAREDE_MAX_DADOS) {
+        p->pos = 0;
+        p->erros_crc++;
+        return;
+    }
+    if (p->pos < PAREDE_CABECALHO + tamanho + 1) return;
+
+    p->pos = 0;
+    if (crc8(&p->pacote[1], PAREDE_CABECALHO - 1 + tamanho) != p->pacote[PAREDE_CABECALHO + tamanho]) {
+        p->erros_crc++;
+        return;
+    }
+    processaPacote(p, agora_us);
+}
+
+bool parede_placa_atualiza(parede_placa_t *p, uint32_t agora_us) {
+    if (!p->agendado || (int32_t)(agora_us - p->instante_exibicao) < 0) return false;
+
+    // Diferença entre o instante combinado e o instante real da exibição
+    int32_t atraso = (int32_t)(agora_us - p->instante_exibicao);
+    if (atraso < p->atraso_min_us) p->atraso_min_us = atraso;
+    if (atraso > p->atraso_max_us) p->atraso_max_us = atraso;
+    p->atraso_soma_us += atraso;
+
+    p->agendado = false;
+    p->exibe(p->agendada, p->ctx);
+    p->quadros_exibidos++;
+    return true;
+}
+
+void parede_mestre_relatorio(const parede_mestre_t *m) {
+    printf("Parede (mestre): %u quadros, %lu bytes, %lu pacotes completos, %lu deltas\n",
+           m->quadro, (unsigned long)m->bytes_enviados,
+           (unsigned long)m->pacotes_completos, (unsigned long)m->pacotes_delta);
+}
+
+void parede_placa_relatorio(const parede_placa_t *p) {
+    printf("Parede (placa %u): %lu exibidos, %lu perdidos, %lu erros de CRC\n",
+           p->id, (unsigned long)p->quadros_exibidos,
+           (unsigned long)p->quadros_perdidos, (unsigned long)p->erros_crc);
+    if (p->quadros_exibidos) {
+        printf("  Desvio do instante de exibicao: min %ld us, media %ld us, max %ld us\n",
+               (long)p->atraso_min_us, (long)(p->atraso_soma_us / p->quadros_exibidos),
+               (long)p->atraso_max_us);
+    }
+}
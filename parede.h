@@ -0,0 +1,114 @@
+#ifndef PAREDE_H
+#define PAREDE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "matriz.h"
+
+/**
+ * Protocolo da parede de LEDs: várias placas, cada uma com sua matriz 5x5,
+ * formam um painel maior. O mestre envia a parte de cada placa (completa ou
+ * só os LEDs que mudaram) e depois um pacote de sincronia em difusão; todas
+ * as placas exibem o quadro no mesmo instante, indicado nesse pacote.
+ *
+ * Formato de cada pacote:
+ *   [PAREDE_INICIO][tipo][destino][quadro][tamanho][dados...][crc8]
+ * O CRC-8 (polinômio 0x07) cobre do tipo até o último byte de dados.
+ */
+
+#define PAREDE_INICIO 0xA5
+#define PAREDE_DIFUSAO 0xFF     // Destino que todas as placas aceitam
+#define PAREDE_MAX_PLACAS 8
+#define PAREDE_MAX_DADOS 100
+#define PAREDE_CABECALHO 5
+#define PAREDE_MAX_PACOTE (PAREDE_CABECALHO + PAREDE_MAX_DADOS + 1)
+
+// A cada quantos quadros o mestre envia as matrizes completas, para as placas se recuperarem de perdas
+#define PAREDE_INTERVALO_COMPLETO 50
+
+// Tipos de pacote
+typedef enum {
+    PAREDE_COMPLETO = 1,  // Dados: 25 cores (G, R, B) na ordem da fita
+    PAREDE_DELTA = 2,     // Dados: pares (índice na fita, G, R, B) dos LEDs que mudaram
+    PAREDE_SINCRONIA = 3  // Dados: número do quadro (16 bits) e atraso até a exibição em us (32 bits)
+} parede_tipo_t;
+
+// Função que transmite os bytes de um pacote (UART, laço local, simulação no host...)
+typedef void (*parede_envia_t)(const uint8_t *dados, size_t tamanho, void *ctx);
+
+// Função que exibe um quadro na matriz da placa
+typedef void (*parede_exibe_t)(const uint32_t fita[NLEDS], void *ctx);
+
+/**
+ * Mestre: recorta a imagem do painel e distribui entre as placas.
+ * As placas são numeradas linha a linha, a partir do canto inferior esquerdo.
+ */
+typedef struct {
+    uint8_t colunas, linhas;
+    uint16_t quadro;
+    uint32_t anterior[PAREDE_MAX_PLACAS][NLEDS];
+    parede_envia_t envia;
+    void *ctx;
+    // Estatísticas
+    uint32_t bytes_enviados;
+    uint32_t pacotes_completos;
+    uint32_t pacotes_delta;
+} parede_mestre_t;
+
+/**
+ * Placa: monta o quadro recebido e o exibe no instante pedido pela sincronia.
+ */
+typedef struct {
+    uint8_t id;
+    parede_exibe_t exibe;
+    void *ctx;
+
+    // Recepção de pacotes
+    uint8_t pacote[PAREDE_MAX_PACOTE];
+    uint8_t pos;
+
+    // Quadro em montagem (espelha o último quadro enviado pelo mestre) e quadro agendado
+    uint32_t pendente[NLEDS];
+    uint32_t agendada[NLEDS];
+    uint8_t quadro_pendente;
+    bool pendente_valido;        // Há dados de um quadro ainda sem sincronia
+    bool sincronizado;           // Falso após uma perda, até chegar um quadro completo
+    bool iniciada;               // Já recebeu ao menos um quadro completo
+    bool agendado;
+    uint32_t instante_exibicao;  // Tempo local (us) em que o quadro agendado deve ser exibido
+    uint16_t ultima_sincronia;
+    bool contando;               // A contagem de perdas começa após a primeira sincronia útil
+
+    // Estatísticas
+    uint32_t quadros_exibidos;
+    uint32_t quadros_perdidos;
+    uint32_t erros_crc;
+    int32_t atraso_min_us, atraso_max_us;
+    int64_t atraso_soma_us;
+} parede_placa_t;
+
+// Prepara o mestre para um painel de colunas x linhas placas
+void parede_mestre_inicia(parede_mestre_t *m, uint8_t colunas, uint8_t linhas,
+                          parede_envia_t envia, void *ctx);
+
+/**
+ * Envia um quadro do painel e a sincronia para exibi-lo daqui a 'atraso_us'.
+ * 'imagem' tem (colunas * WIDTH) x (linhas * HEIGHT) cores, linha a linha, com y crescendo para cima.
+ */
+void parede_mestre_envia_quadro(parede_mestre_t *m, const uint32_t *imagem, uint32_t atraso_us);
+
+// Prepara uma placa com o seu número no painel
+void parede_placa_inicia(parede_placa_t *p, uint8_t id, parede_exibe_t exibe, void *ctx);
+
+// Entrega um byte recebido à placa; 'agora_us' é o tempo local da recepção
+void parede_placa_recebe(parede_placa_t *p, uint8_t byte, uint32_t agora_us);
+
+// Exibe o quadro agendado se o instante já chegou; retorna verdadeiro se exibiu
+bool parede_placa_atualiza(parede_placa_t *p, uint32_t agora_us);
+
+// Imprimem as estatísticas do mestre e da placa
+void parede_mestre_relatorio(const parede_mestre_t *m);
+void parede_placa_relatorio(const parede_placa_t *p);
+
+#endif
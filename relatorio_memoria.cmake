@@ -0,0 +1,64 @@
+# Relatório de memória executado após a compilação do firmware.
+#
+# Variáveis esperadas (passadas com -D):
+#   ELF     - caminho do executável gerado
+#   SIZE    - utilitário arm-none-eabi-size
+#   SU_DIR  - diretório com os arquivos .su gerados por -fstack-usage
+#   FILTRO  - diretório do projeto; só entram os arquivos com esse prefixo (comparação literal)
+#   TOP     - quantidade de funções listadas
+
+if (NOT TOP)
+    set(TOP 15)
+endif ()
+
+# Tamanho das seções do executável
+if (SIZE AND EXISTS "${SIZE}")
+    execute_process(COMMAND ${SIZE} -A -d ${ELF} OUTPUT_VARIABLE secoes)
+    message("== Secoes de ${ELF} ==\n${secoes}")
+endif ()
+
+# Quadros de pilha por função, do maior para o menor
+file(GLOB_RECURSE arquivos_su "${SU_DIR}/*.su")
+set(entradas "")
+foreach (arquivo ${arquivos_su})
+    file(STRINGS ${arquivo} linhas)
+    foreach (linha ${linhas})
+        # Formato: arquivo:linha:coluna:funcao<TAB>bytes<TAB>qualificador
+        if (linha MATCHES "^(.*):[0-9]+:[0-9]+:([^\t]+)\t([0-9]+)\t(.*)$")
+            set(origem ${CMAKE_MATCH_1})
+            set(funcao ${CMAKE_MATCH_2})
+            set(bytes ${CMAKE_MATCH_3})
+            set(tipo ${CMAKE_MATCH_4})
+            # Comparação literal: o caminho pode ter caracteres especiais de expressão regular
+            if (FILTRO)
+                string(FIND "${origem}" "${FILTRO}" posicao)
+                if (NOT posicao EQUAL 0)
+                    continue()
+                endif ()
+            endif ()
+            get_filename_component(nome ${origem} NAME)
+            # Prefixo com zeros para que a ordenação alfabética siga o tamanho
+            string(LENGTH "${bytes}" n)
+            math(EXPR zeros "8 - ${n}")
+            string(SUBSTRING "00000000" 0 ${zeros} prefixo)
+            list(APPEND entradas "${prefixo}${bytes}|${nome}:${funcao} (${tipo})")
+        endif ()
+    endforeach ()
+endforeach ()
+
+list(SORT entradas)
+list(REVERSE entradas)
+list(LENGTH entradas total)
+if (total GREATER TOP)
+    list(SUBLIST entradas 0 ${TOP} entradas)
+endif ()
+
+set(relatorio "")
+foreach (entrada ${entradas})
+    string(REPLACE "|" ";" campos "${entrada}")
+    list(GET campos 0 bytes)
+    list(GET campos 1 descricao)
+    string(REGEX REPLACE "^0+([0-9])" "\\1" bytes "${bytes}")
+    string(APPEND relatorio "  ${bytes}\t${descricao}\n")
+endforeach ()
+message("== Maiores quadros de pilha (${total} funcoes do projeto) ==\n${relatorio}")
@@ -0,0 +1,102 @@
+#include "hardware/dma.h"  // Canais e temporizadores DMA
+#include "hardware/irq.h"  // Interrupção de fim do clipe
+#include "hardware/clocks.h"  // clock_get_hz, para o ritmo do temporizador DMA
+#include "hardware/sync.h"  // __wfi e máscara de interrupções, para a CPU dormir durante o clipe
+#include "reproducao.h"
+
+// Tempo aproximado que o canal de dados leva até o último LED entrar no FIFO
+// (24 bits a 800 kHz por LED, descontando os 8 LEDs que cabem no FIFO juntado)
+#define TEMPO_DADOS_US ((NLEDS - 8) * 30)
+
+static const uint32_t *enderecos[REPRODUCAO_MAX_QUADROS + 1];
+static uint32_t lixo;  // Origem e destino das transferências vazias do canal de ritmo
+static volatile bool terminou;
+static int canal_dados;
+
+// O endereço nulo escrito no gatilho do canal de dados levanta a sua interrupção
+static void fimClipe() {
+    if (dma_channel_get_irq1_status(canal_dados)) {
+        dma_channel_acknowledge_irq1(canal_dados);
+        terminou = true;
+    }
+}
+
+bool reproducao_toca(PIO pio, uint sm, const uint32_t (*quadros)[NLEDS],
+                     uint num_quadros, uint32_t periodo_ms) {
+    if (num_quadros > REPRODUCAO_MAX_QUADROS) num_quadros = REPRODUCAO_MAX_QUADROS;
+
+    int dados = dma_claim_unused_channel(false);
+    int controle = dma_claim_unused_channel(false);
+    int ritmo = dma_claim_unused_channel(false);
+    int temporizador = dma_claim_unused_timer(false);
+    if (dados < 0 || controle < 0 || ritmo < 0 || temporizador < 0) {
+        if (dados >= 0) dma_channel_unclaim(dados);
+        if (controle >= 0) dma_channel_unclaim(controle);
+        if (ritmo >= 0) dma_channel_unclaim(ritmo);
+        if (temporizador >= 0) dma_timer_unclaim(temporizador);
+        return false;
+    }
+
+    // Tabela com o endereço de cada quadro, terminada por nulo
+    for (uint i = 0; i < num_quadros; i++) {
+        enderecos[i] = quadros[i];
+    }
+    enderecos[num_quadros] = NULL;
+
+    // Temporizador DMA em REPRODUCAO_TICK_HZ: clk_sys * 1 / divisor
+    dma_timer_set_fraction(temporizador, 1, clock_get_hz(clk_sys) / REPRODUCAO_TICK_HZ);
+    uint32_t periodo_us = periodo_ms * 1000;
+    uint32_t ticks = periodo_us > TEMPO_DADOS_US
+                   ? (periodo_us - TEMPO_DADOS_US) / (1000000 / REPRODUCAO_TICK_HZ) : 1;
+    if (!ticks) ticks = 1;
+
+    // Ritmo: transferências vazias no passo do temporizador, depois encadeia o controle
+    dma_channel_config c = dma_channel_get_default_config(ritmo);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, dma_get_timer_dreq(temporizador));
+    channel_config_set_chain_to(&c, controle);
+    dma_channel_configure(ritmo, &c, &lixo, &lixo, ticks, false);
+
+    // Dados: envia um quadro ao FIFO do PIO e encadeia o ritmo; só interrompe no gatilho nulo
+    c = dma_channel_get_default_config(dados);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+    channel_config_set_chain_to(&c, ritmo);
+    channel_config_set_irq_quiet(&c, true);
+    dma_channel_configure(dados, &c, &pio->txf[sm], NULL, NLEDS, false);
+
+    // Controle: escreve o próximo endereço da tabela no gatilho do canal de dados
+    c = dma_channel_get_default_config(controle);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    dma_channel_configure(controle, &c, &dma_hw->ch[dados].al3_read_addr_trig, enderecos, 1, false);
+
+    canal_dados = dados;
+    terminou = false;
+    dma_channel_set_irq1_enabled(dados, true);
+    irq_add_shared_handler(DMA_IRQ_1, fimClipe, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    // A partir daqui o clipe inteiro roda no DMA; a CPU só acorda em interrupções
+    dma_channel_start(controle);
+
+    // Com as interrupções mascaradas entre o teste e o __wfi, o fim do clipe não
+    // pode escapar entre os dois: a interrupção pendente ainda acorda o __wfi
+    uint32_t estado = save_and_disable_interrupts();
+    while (!terminou) {
+        __wfi();
+        restore_interrupts(estado);
+        estado = save_and_disable_interrupts();
+    }
+    restore_interrupts(estado);
+
+    dma_channel_set_irq1_enabled(dados, false);
+    irq_remove_handler(DMA_IRQ_1, fimClipe);
+    dma_channel_unclaim(dados);
+    dma_channel_unclaim(controle);
+    dma_channel_unclaim(ritmo);
+    dma_timer_unclaim(temporizador);
+    return true;
+}
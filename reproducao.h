@@ -0,0 +1,34 @@
+#ifndef REPRODUCAO_H
+#define REPRODUCAO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware/pio.h"
+#include "matriz.h"
+
+// Quantidade máxima de quadros em um clipe
+#define REPRODUCAO_MAX_QUADROS 64
+
+// Frequência do temporizador DMA que marca o ritmo entre quadros
+#define REPRODUCAO_TICK_HZ 10000
+
+/**
+ * Reproduz um clipe já renderizado sem nenhum trabalho da CPU por quadro.
+ *
+ * Três canais DMA formam um laço: o canal de controle escreve o endereço do
+ * próximo quadro no gatilho do canal de dados, que envia os 25 LEDs ao FIFO do
+ * PIO e encadeia o canal de ritmo; este faz transferências vazias pacejadas
+ * por um temporizador DMA até completar o período e encadeia de volta o
+ * controle. Um endereço nulo no fim da tabela encerra o laço e gera a
+ * interrupção que acorda a CPU, que dorme (__wfi) durante todo o clipe.
+ *
+ * pio, sm = Máquina de estado do WS2812, que deve estar ociosa.
+ * quadros = Clipe com num_quadros quadros, na ordem da fita.
+ * periodo_ms = Intervalo entre o início de quadros consecutivos.
+ *
+ * Retorna falso se não houver canais ou temporizador DMA livres.
+ */
+bool reproducao_toca(PIO pio, uint sm, const uint32_t (*quadros)[NLEDS],
+                     uint num_quadros, uint32_t periodo_ms);
+
+#endif
@@ -4,20 +4,39 @@
 #include "pico/stdlib.h"  // Funções padrão do Raspberry Pi Pico (GPIO, temporização, inicialização)
 #include "hardware/pio.h"  // Controle do PIO (Programmable Input/Output, usado para os LEDs WS2812)
 #include "hardware/dma.h"  // Controle do DMA (Direct Memory Access, usado para atualizar LEDs)
+#include "hardware/irq.h"  // Interrupções (ex.: fim do DMA, usado no rastreamento)
 #include "pico/bootrom.h"  // Funções relacionadas ao bootloader (ex.: reset_usb_boot para reinício no modo bootloader)
 #include "ws2812.pio.h"  // Programa PIO e inicialização para controlar os LEDs WS2812
+#include "matriz.h"  // Dimensões da matriz, cor RGB e mapeamento das coordenadas
+#include "timeline.h"  // Animações por quadros-chave com interpolação
+#include "memoria.h"  // Medição do uso de pilha e SRAM
+#include "cobra.h"  // Lógica do jogo da cobra
+#include "trace.h"  // Rastreamento de eventos com exportação para o Chrome trace
+#include "governador.h"  // Ajuste dinâmico do clk_sys com recálculo dos divisores PIO
+#include "parede.h"  // Protocolo da parede de LEDs com várias placas
+#include "reproducao.h"  // Reprodução de clipes por DMA encadeado, sem a CPU
+#include "bitboard.h"  // Camada monocromática em bits e autômatos celulares
+#include "hardware/uart.h"  // UART usado pela parede de LEDs
+#include "gerenciador_pio.h"  // Carga de programas e reserva de máquinas de estado nos dois blocos PIO
+#include "blink.pio.h"  // Programa PIO que alterna um pino, usado no pulso e no tom do buzzer
+#include "teclado.pio.h"  // Programa PIO que varre o teclado matricial
 
 
 #define PIN_TX 7
-#define NLEDS 25
-#define WIDTH 5
-#define HEIGHT 5
+#define TAXA_QUADROS 50  // Quadros por segundo das animações por quadros-chave
+#define PEIXE_PERIODO_MS 50  // Intervalo entre os quadros pré-renderizados do peixe
+#define PEIXE_QUADROS (2000 / PEIXE_PERIODO_MS + 1)  // Do primeiro ao último quadro-chave, inclusive
 
 #define ROWS 4
 #define COLS 4
 uint8_t row_pins[ROWS] = {2, 3, 4, 5};
 uint8_t col_pins[COLS] = {6, 10, 8, 9};
 
+// Varredura pelo PIO: as linhas são GP2-GP5 seguidos e as colunas ficam entre GP6 e GP10
+#define TECLADO_LINHA_BASE 2
+#define TECLADO_COLUNA_BASE 6
+#define TECLADO_SM_HZ 1000000  // Clock da máquina de estado do teclado, mantido pelo governador
+
 const char keys[ROWS][COLS] = {
     {'1', '2', '3', 'A'},
     {'4', '5', '6', 'B'},
@@ -26,19 +45,63 @@ const char keys[ROWS][COLS] = {
 };
 
 #define BUZZER_PIN 21  // Definindo o pino do buzzer
+#define PIN_PULSO 11  // LED de pulso (heartbeat) gerado pelo PIO
+#define PULSO_HZ 2  // Piscadas por segundo do LED de pulso
+#define BLINK_SM_HZ 1000000  // Clock das máquinas de estado do programa blink, mantido pelo governador
+
+#define COBRA_PERIODO_MS 400  // Intervalo entre os passos automáticos do jogo da cobra
+#define COBRA_LATENCIA_MAX_US 2000  // Limite entre a tecla e o início do DMA que a exibe
+
+// Parede de LEDs: várias placas ligadas pelo UART formam um painel maior (opção PAREDE do CMake)
+#ifndef PAREDE_HABILITADA
+#define PAREDE_HABILITADA 0
+#endif
+#ifndef PAREDE_ID
+#define PAREDE_ID 0  // Número desta placa no painel; a placa 0 é o mestre
+#endif
+#ifndef PAREDE_COLUNAS
+#define PAREDE_COLUNAS 2  // Placas por linha do painel
+#endif
+#ifndef PAREDE_LINHAS
+#define PAREDE_LINHAS 1  // Linhas de placas do painel
+#endif
+#ifndef PAREDE_LACO_UART
+#define PAREDE_LACO_UART 0  // 1 = a placa do mestre recebe pelo fio TX->RX em vez de internamente
+#endif
+_Static_assert(PAREDE_COLUNAS * PAREDE_LINHAS <= PAREDE_MAX_PLACAS,
+               "A parede aceita no maximo PAREDE_MAX_PLACAS placas");
+_Static_assert(PAREDE_ID < PAREDE_COLUNAS * PAREDE_LINHAS,
+               "PAREDE_ID precisa ser menor que PAREDE_COLUNAS * PAREDE_LINHAS");
+#define PAREDE_UART uart0
+#define PAREDE_PINO_TX 16
+#define PAREDE_PINO_RX 17
+#define PAREDE_BAUD 921600
+#define PAREDE_PERIODO_MS 40  // Intervalo entre quadros enviados pelo mestre
+#define PAREDE_ATRASO_US 5000  // Folga entre a sincronia e a exibição, igual para todas as placas
+#define PAREDE_DEMO_MS 10000  // Duração da demonstração do mestre
 
 static PIO pio;
 static int sm;
+static pio_recurso_t fita_pio;  // Máquina de estado do WS2812
+static pio_recurso_t pulso_pio;  // Máquina de estado do LED de pulso, quando ligado
+static pio_recurso_t teclado_pio;  // Máquina de estado do teclado, quando a varredura está no PIO
 static uint dma_chan;
 static uint32_t fitaEd[NLEDS];
-
-// Função para representar a cor em formato RGB
-static inline uint32_t urgb_u32(uint8_t r, uint8_t g, uint8_t b) {
-    return ((uint32_t)(g) << 24) | ((uint32_t)(r) << 16) | ((uint32_t)(b) << 8);
+static uint64_t ultimo_dma_us;  // Instante em que a última transferência DMA foi iniciada
+
+#if TRACE_HABILITADO
+// Registra o fim de cada transferência DMA da fita
+static void fimDMA() {
+    if (dma_channel_get_irq0_status(dma_chan)) {
+        dma_channel_acknowledge_irq0(dma_chan);
+        TRACE(TRACE_DMA, TRACE_FIM, NLEDS);
+    }
 }
+#endif
 
 // Função para atualizar os LEDs
 static void atualizaFita() {
+    TRACE(TRACE_QUADRO, TRACE_INICIO, 0);
     dma_channel_wait_for_finish_blocking(dma_chan);
     while (!pio_sm_is_tx_fifo_empty(pio, sm)) {
         sleep_us(10);
@@ -47,8 +110,20 @@ static void atualizaFita() {
     channel_config_set_read_increment(&c, true);
     channel_config_set_write_increment(&c, false);
     channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+    ultimo_dma_us = time_us_64();
+    TRACE(TRACE_DMA, TRACE_INICIO, NLEDS);
     dma_channel_configure(dma_chan, &c, &pio->txf[sm], fitaEd, NLEDS, true);
     sleep_us(300);
+    TRACE(TRACE_QUADRO, TRACE_FIM, 0);
+}
+
+// Aguarda o último quadro sair por completo do PIO (usado antes de trocar o clock)
+static void aguardaFitaOciosa() {
+    dma_channel_wait_for_finish_blocking(dma_chan);
+    while (!pio_sm_is_tx_fifo_empty(pio, sm)) {
+        sleep_us(10);
+    }
+    sleep_us(50); // Tempo para os últimos bits deixarem o registrador de deslocamento
 }
 
 // Apaga os LEDs
@@ -150,40 +225,39 @@ void animacaoCobraExplosiva() {
         sleep_ms(200); // Intervalo entre piscadas
     }
 }
-// Animação "Ondas Crescentes"
-void animacaoOndasCrescentes() {
-    uint32_t cor_onda = urgb_u32(0, 0, 255); // Azul para as ondas
-    uint32_t cor_base = urgb_u32(0, 0, 0);   // LEDs apagados
-
-    // Cria a onda crescente
-    for (int onda = 1; onda <= HEIGHT; onda++) {
-        memset(fitaEd, 0, sizeof(fitaEd)); // Limpa todos os LEDs
-
-        // Acende os LEDs da onda atual
-        for (int i = 0; i < onda; i++) {
-            for (int j = 0; j < WIDTH; j++) {
-                fitaEd[i * WIDTH + j] = cor_onda; // Acende uma linha completa
-            }
-        }
 
+/**
+ * Reproduz uma linha do tempo de quadros-chave na taxa de quadros pedida.
+ * Os quadros são agendados em tempo absoluto, então o custo de desenhar
+ * e enviar cada quadro não acumula atraso ao longo da animação.
+ */
+static void tocaTimeline(const timeline_t *tl, uint32_t fps) {
+    uint32_t duracao_us = timeline_duracao_ms(tl) * 1000;
+    uint32_t periodo_us = 1000000 / fps;
+    absolute_time_t inicio = get_absolute_time();
+
+    for (uint32_t t_us = 0; ; t_us += periodo_us) {
+        if (t_us > duracao_us) t_us = duracao_us; // Garante que a pose final seja exibida
+        timeline_renderiza(tl, t_us / 1000, fitaEd);
         atualizaFita();
-        sleep_ms(200); // Intervalo entre cada "crescimento" da onda
+        if (t_us == duracao_us) break;
+        TRACE(TRACE_ESPERA, TRACE_INICIO, periodo_us / 1000);
+        sleep_until(delayed_by_us(inicio, t_us + periodo_us));
+        TRACE(TRACE_ESPERA, TRACE_FIM, periodo_us / 1000);
     }
+}
 
-    // Reverte a onda (desaparecendo)
-    for (int onda = HEIGHT; onda >= 1; onda--) {
-        memset(fitaEd, 0, sizeof(fitaEd)); // Limpa todos os LEDs
-
-        // Mantém as linhas até a altura atual
-        for (int i = 0; i < onda; i++) {
-            for (int j = 0; j < WIDTH; j++) {
-                fitaEd[i * WIDTH + j] = cor_onda; // Acende uma linha completa
-            }
-        }
+// Animação "Ondas Crescentes"
+void animacaoOndasCrescentes() {
+    // Um bloco azul do tamanho da matriz sobe a partir de baixo e volta a descer
+    static const quadro_chave_t chaves[] = {
+        {   0, 0, PIXELS(-4), 0, 0, 255, 255, SUAVE_LINEAR },
+        {1000, 0, PIXELS(0),  0, 0, 255, 255, SUAVE_ENTRADA_SAIDA_QUAD },
+        {2000, 0, PIXELS(-4), 0, 0, 255, 255, SUAVE_ENTRADA_SAIDA_QUAD },
+    };
+    static const timeline_t onda = { 0x1FFFFFF, chaves, sizeof(chaves) / sizeof(chaves[0]) };
 
-        atualizaFita();
-        sleep_ms(200); // Intervalo entre cada "diminuição" da onda
-    }
+    tocaTimeline(&onda, TAXA_QUADROS);
 }
 
 void animacaoFlorCrescendo() {
@@ -263,8 +337,18 @@ void animacaoSol() {
     uint32_t cor_centro = urgb_u32(255, 255, 0); 
     uint32_t cor_raio = urgb_u32(255, 165, 0);   
 
-    const int raios[16] = {
-        1, 3, 5, 9, 15, 19, 21, 23, 20, 18, 16, 10, 4, 0, 2, 8
+    // Os 16 raios, divididos em dois grupos que acendem alternadamente
+    const bitboard_t raios[2] = {
+        BB_LINHAS(0b00011,
+                  0b11000,
+                  0b00000,
+                  0b10000,
+                  0b10110),
+        BB_LINHAS(0b01000,
+                  0b00011,
+                  0b00001,
+                  0b00011,
+                  0b01001),
     };
 
     for (int ciclo = 0; ciclo < 8; ciclo++) {
@@ -275,11 +359,7 @@ void animacaoSol() {
         fitaEd[12] = cor_centro;
 
         
-        for (int i = 0; i < 16; i++) {
-            if (i % 2 == ciclo % 2) {
-                fitaEd[raios[i]] = cor_raio;
-            }
-        }
+        bb_pinta(raios[ciclo % 2], cor_raio, fitaEd);
 
         atualizaFita();
         sleep_ms(300); 
@@ -292,39 +372,33 @@ void animacaoSol() {
 
 // Animação do peixe
 void peixe() {
-    uint32_t cor = urgb_u32(62, 125, 255); // Azul claro
-    const uint8_t frames[][15] = {
-        {14},                              // Quadro 0
-        {5, 13, 14, 15},                  // Quadro 1
-        {4, 5, 6, 12, 13, 14, 15, 16, 24},// Quadro 2
-        {3, 5, 6, 7, 11, 12, 13, 14, 15, 16, 17, 23}, // Quadro 3
-        {2, 6, 7, 8, 10, 11, 12, 13, 14, 15, 16, 17, 18, 22}, // Quadro 4
-        {1, 5, 7, 8, 9, 10, 11, 12, 13, 14, 15, 17, 18, 19, 21}, // Quadro 5
-        {0, 6, 8, 9, 10, 11, 12, 13, 16, 18, 19, 20}, // Quadro 6
-        {7, 9, 10, 11, 12, 17, 19},        // Quadro 7
-        {8, 10, 11, 18},                   // Quadro 8
-        {9, 10, 19},                       // Quadro 9
-        {}                                 // Quadro 10 (todos apagados)
+    // O peixe atravessa a matriz da esquerda para a direita, entrando e saindo pelas bordas
+    static const quadro_chave_t chaves[] = {
+        {   0, PIXELS(-4), 0, 62, 125, 255, 255, SUAVE_LINEAR },
+        {2000, PIXELS(5),  0, 62, 125, 255, 255, SUAVE_LINEAR },
     };
-    
-    const size_t frame_sizes[] = {
-        1, 4, 9, 12, 14, 15, 12, 7, 4, 3, 0
+    static const timeline_t nado = {
+        BB_LINHAS(0b00010,
+                  0b10111,
+                  0b11111,
+                  0b10111,
+                  0b00010),
+        chaves, sizeof(chaves) / sizeof(chaves[0])
     };
 
-    for (int i = 0; i <= 10; i++) {
-        
-        // Limpa a fita antes de cada quadro
-        memset(fitaEd, 0, sizeof(fitaEd));
+    // O clipe inteiro é renderizado antes e reproduzido pelo DMA, sem a CPU a cada quadro
+    static uint32_t clipe[PEIXE_QUADROS][NLEDS];
 
-        // Ativa os LEDs especificados para o quadro atual
-        for (size_t j = 0; j < frame_sizes[i]; j++) {
-            fitaEd[frames[i][j]] = cor;
-        }
+    for (int i = 0; i < PEIXE_QUADROS; i++) {
+        timeline_renderiza(&nado, i * PEIXE_PERIODO_MS, clipe[i]);
+    }
 
-        // Atualiza a fita e aguarda
-        atualizaFita();
-        sleep_ms(200);
+    aguardaFitaOciosa();
+    if (!reproducao_toca(pio, sm, clipe, PEIXE_QUADROS, PEIXE_PERIODO_MS)) {
+        // Sem canais DMA livres: a CPU desenha cada quadro da linha do tempo
+        tocaTimeline(&nado, 1000 / PEIXE_PERIODO_MS);
     }
+    memcpy(fitaEd, clipe[PEIXE_QUADROS - 1], sizeof(fitaEd));
 }
 
 /// Animação mario
@@ -368,17 +442,61 @@ void animacaoMario() {
 }
 
 
+/**
+ * Coloca o programa blink para alternar 'pino' na frequência pedida.
+ * Cada meia onda dura y + 3 ciclos do clock da máquina de estado.
+ */
+static bool iniciaBlink(pio_recurso_t *recurso, uint pino, uint32_t frequencia_hz) {
+    if (!gerenciador_aloca(&blink_program, "blink", recurso)) return false;
+
+    blink_program_init(recurso->pio, recurso->sm, recurso->offset, pino);
+    governador_registra_sm(recurso->pio, recurso->sm, BLINK_SM_HZ);
+    pio_sm_set_enabled(recurso->pio, recurso->sm, true);
+    pio_sm_put_blocking(recurso->pio, recurso->sm, BLINK_SM_HZ / (2 * frequencia_hz) - 3);
+    return true;
+}
+
+// Liga ou desliga o LED de pulso; o programa blink só ocupa o PIO enquanto ele estiver ligado
+void alternaPulso() {
+    if (pulso_pio.programa) {
+        gerenciador_libera(&pulso_pio);
+        gpio_init(PIN_PULSO);
+        printf("Pulso desligado\n");
+    } else if (iniciaBlink(&pulso_pio, PIN_PULSO, PULSO_HZ)) {
+        printf("Pulso ligado no GP%d\n", PIN_PULSO);
+    } else {
+        printf("Sem maquina de estado livre para o pulso\n");
+    }
+}
+
 // Função para gerar um sinal sonoro
 void emiteSom(uint32_t duracao_ms, uint32_t frequencia_hz) {
+    pio_recurso_t tom;
+
+    // O PIO gera a onda quadrada; sem máquina de estado livre, o tom é feito pela CPU
+    if (iniciaBlink(&tom, BUZZER_PIN, frequencia_hz)) {
+        TRACE(TRACE_SOM, TRACE_INICIO, frequencia_hz);
+        sleep_ms(duracao_ms);
+        TRACE(TRACE_SOM, TRACE_FIM, frequencia_hz);
+        gerenciador_libera(&tom);
+
+        // Devolve o pino ao SIO, em nível baixo, como deixado por init_gpio
+        gpio_init(BUZZER_PIN);
+        gpio_set_dir(BUZZER_PIN, GPIO_OUT);
+        return;
+    }
+
     uint32_t periodo = 1000000 / frequencia_hz;  // Calcula o período do sinal (em microssegundos)
     uint32_t ciclos = (duracao_ms * 1000) / periodo;  // Calcula quantos ciclos serão emitidos
 
+    TRACE(TRACE_SOM, TRACE_INICIO, frequencia_hz);
     for (uint32_t i = 0; i < ciclos; i++) {
         gpio_put(BUZZER_PIN, 1);  // Ativa o buzzer
         sleep_us(periodo / 2);    // Espera metade do período
         gpio_put(BUZZER_PIN, 0);  // Desativa o buzzer
         sleep_us(periodo / 2);    // Espera a outra metade do período
     }
+    TRACE(TRACE_SOM, TRACE_FIM, frequencia_hz);
 }
 
 /**
@@ -543,8 +661,58 @@ void init_gpio() {
     gpio_set_dir(BUZZER_PIN, GPIO_OUT);  // Define o pino como saída
 }
 
-// Função para escanear o teclado e retornar a tecla pressionada
-char scan_keypad() {
+// Passa a varredura do teclado para o PIO; retorna falso se não houver máquina de estado livre
+static bool iniciaTecladoPIO() {
+    if (!gerenciador_aloca(&teclado_program, "teclado", &teclado_pio)) return false;
+
+    teclado_program_init(teclado_pio.pio, teclado_pio.sm, teclado_pio.offset,
+                         TECLADO_LINHA_BASE, TECLADO_COLUNA_BASE);
+    governador_registra_sm(teclado_pio.pio, teclado_pio.sm, TECLADO_SM_HZ);
+    pio_sm_set_enabled(teclado_pio.pio, teclado_pio.sm, true);
+    return true;
+}
+
+// Devolve a máquina de estado do teclado e volta as linhas ao SIO, como em init_gpio
+static void paraTecladoPIO() {
+    gerenciador_libera(&teclado_pio);
+    for (int i = 0; i < ROWS; i++) {
+        gpio_init(row_pins[i]);
+        gpio_set_dir(row_pins[i], GPIO_OUT);
+        gpio_put(row_pins[i], 1);
+    }
+}
+
+// Alterna a varredura do teclado entre o PIO e a CPU
+void alternaTecladoPIO() {
+    if (teclado_pio.programa) {
+        paraTecladoPIO();
+        printf("Teclado varrido pela CPU\n");
+    } else if (iniciaTecladoPIO()) {
+        printf("Teclado varrido pelo PIO\n");
+    } else {
+        printf("Sem maquina de estado livre para o teclado\n");
+    }
+}
+
+// Pede uma varredura ao PIO e procura a primeira tecla, na mesma ordem da varredura pela CPU
+static char leTecladoPIO() {
+    pio_sm_put_blocking(teclado_pio.pio, teclado_pio.sm, 0);
+    uint32_t leitura = pio_sm_get_blocking(teclado_pio.pio, teclado_pio.sm) >> 12;
+
+    for (int row = 0; row < ROWS; row++) {
+        for (int col = 0; col < COLS; col++) {
+            if (!((leitura >> (row * 5 + col_pins[col] - TECLADO_COLUNA_BASE)) & 1)) {
+                return keys[row][col];
+            }
+        }
+    }
+    return 0;
+}
+
+// Varre as linhas do teclado e retorna a primeira tecla pressionada (0 se nenhuma)
+static char leTeclado() {
+    if (teclado_pio.programa) return leTecladoPIO();
+
     for (int row = 0; row < ROWS; row++) {
         gpio_put(row_pins[row], 0);
         for (int col = 0; col < COLS; col++) {
@@ -558,6 +726,207 @@ char scan_keypad() {
     return 0;
 }
 
+// Função para escanear o teclado e retornar a tecla pressionada
+char scan_keypad() {
+    static char anterior = 0;  // Última leitura, para rastrear só o momento em que a tecla desce
+    char key = leTeclado();
+
+    if (key && key != anterior) {
+        TRACE(TRACE_TECLA, TRACE_INSTANTE, key);
+    }
+    anterior = key;
+    return key;
+}
+
+/**
+ * Jogo da cobra controlado pelo teclado: 2 sobe, 8 desce, 4 vai para a
+ * esquerda, 6 para a direita e A encerra. A cobra anda sozinha a cada
+ * COBRA_PERIODO_MS; uma mudança de direção dá o passo imediatamente.
+ * A latência medida vai do início da leitura anterior do teclado, a última em
+ * que a tecla ainda estava solta, até o início do DMA que mostra o passo. Assim
+ * ela inclui o intervalo de 1 ms entre as leituras e o tempo de varredura, e é
+ * um limite superior do tempo entre tocar a tecla e o quadro começar a sair.
+ */
+void jogoCobra() {
+    cobra_jogo_t jogo;
+    uint32_t latencia_min = UINT32_MAX, latencia_max = 0, estouros = 0;
+    uint64_t latencia_soma = 0;
+    uint32_t medidas = 0;
+    char anterior = 0;
+    uint64_t t_leitura_anterior = time_us_64();
+
+    governador_desempenho();
+    cobra_inicia(&jogo, time_us_32());
+    cobra_renderiza(&jogo, fitaEd);
+    atualizaFita();
+    absolute_time_t proximo = make_timeout_time_ms(COBRA_PERIODO_MS);
+
+    while (!jogo.fim) {
+        uint64_t t_leitura = time_us_64();
+        char key = scan_keypad();
+
+        // Reage apenas à borda de descida da tecla
+        if (key && key != anterior) {
+            // A tecla desceu depois do início da leitura anterior, que ainda a viu solta
+            uint64_t t_tecla = t_leitura_anterior;
+            int direcao = -1;
+
+            switch (key) {
+                case '2': direcao = COBRA_CIMA; break;
+                case '8': direcao = COBRA_BAIXO; break;
+                case '4': direcao = COBRA_ESQUERDA; break;
+                case '6': direcao = COBRA_DIREITA; break;
+                case 'A': jogo.fim = true; break;
+                default: break;
+            }
+
+            if (direcao >= 0 && cobra_muda_direcao(&jogo, direcao)) {
+                cobra_passo(&jogo);
+                cobra_renderiza(&jogo, fitaEd);
+                atualizaFita();
+
+                uint32_t latencia = (uint32_t)(ultimo_dma_us - t_tecla);
+                if (latencia < latencia_min) latencia_min = latencia;
+                if (latencia > latencia_max) latencia_max = latencia;
+                if (latencia > COBRA_LATENCIA_MAX_US) estouros++;
+                latencia_soma += latencia;
+                medidas++;
+
+                // O passo manual reinicia a contagem do passo automático
+                proximo = make_timeout_time_ms(COBRA_PERIODO_MS);
+            }
+        }
+        anterior = key;
+        t_leitura_anterior = t_leitura;
+
+        // Passo automático em ritmo fixo, agendado em tempo absoluto
+        if (!jogo.fim && time_reached(proximo)) {
+            cobra_passo(&jogo);
+            cobra_renderiza(&jogo, fitaEd);
+            atualizaFita();
+            proximo = delayed_by_ms(proximo, COBRA_PERIODO_MS);
+        }
+
+        sleep_ms(1);
+    }
+
+    // Fim de jogo: pisca a cobra em vermelho
+    for (int i = 0; i < 3; i++) {
+        acendeLEDS(urgb_u32(128, 0, 0));
+        sleep_ms(150);
+        cobra_renderiza(&jogo, fitaEd);
+        atualizaFita();
+        sleep_ms(150);
+    }
+    apagaLEDS();
+
+    printf("Fim de jogo! Pontos: %u\n", jogo.pontos);
+    if (medidas) {
+        printf("Latencia tecla->DMA (pior caso, com o intervalo de leitura): min %lu us, media %lu us, max %lu us, %lu acima de %u us\n",
+               (unsigned long)latencia_min, (unsigned long)(latencia_soma / medidas),
+               (unsigned long)latencia_max, (unsigned long)estouros, COBRA_LATENCIA_MAX_US);
+    }
+}
+
+#if PAREDE_HABILITADA
+static parede_placa_t placa_parede;
+
+// Exibe nesta matriz o quadro recebido pela parede
+static void exibeQuadroParede(const uint32_t fita[NLEDS], void *ctx) {
+    memcpy(fitaEd, fita, sizeof(fitaEd));
+    atualizaFita();
+}
+
+// Lê os bytes recebidos e exibe o quadro agendado quando chegar a hora
+static void atendeParede() {
+    while (uart_is_readable(PAREDE_UART)) {
+        parede_placa_recebe(&placa_parede, uart_getc(PAREDE_UART), time_us_32());
+    }
+    parede_placa_atualiza(&placa_parede, time_us_32());
+}
+
+// Transmite os pacotes do mestre pelo UART
+static void enviaParede(const uint8_t *dados, size_t tamanho, void *ctx) {
+#if PAREDE_LACO_UART
+    // No teste em laço os bytes voltam pelo RX durante o envio, então o FIFO de recepção é esvaziado junto
+    for (size_t i = 0; i < tamanho; i++) {
+        while (!uart_is_writable(PAREDE_UART)) {
+            atendeParede();
+        }
+        uart_putc_raw(PAREDE_UART, dados[i]);
+    }
+#else
+    uart_write_blocking(PAREDE_UART, dados, tamanho);
+
+    // A placa do mestre recebe os mesmos bytes quando eles terminam de sair pelo fio
+    uart_tx_wait_blocking(PAREDE_UART);
+    uint32_t agora = time_us_32();
+    for (size_t i = 0; i < tamanho; i++) {
+        parede_placa_recebe(&placa_parede, dados[i], agora);
+    }
+#endif
+}
+
+static void iniciaParede() {
+    uart_init(PAREDE_UART, PAREDE_BAUD);
+    gpio_set_function(PAREDE_PINO_TX, GPIO_FUNC_UART);
+    gpio_set_function(PAREDE_PINO_RX, GPIO_FUNC_UART);
+    governador_registra_uart(PAREDE_UART, PAREDE_BAUD);
+    parede_placa_inicia(&placa_parede, PAREDE_ID, exibeQuadroParede, NULL);
+}
+
+/**
+ * Demonstração do mestre: uma barra colorida com rastro atravessa o painel
+ * inteiro. Cada quadro é distribuído às placas e exibido por todas juntas.
+ */
+void demoParede() {
+    static uint32_t imagem[PAREDE_LINHAS * HEIGHT][PAREDE_COLUNAS * WIDTH];
+    const int largura = PAREDE_COLUNAS * WIDTH;
+    static parede_mestre_t mestre;  // ~830 bytes, fora da pilha de 2 KB do core0
+
+    governador_desempenho();
+    parede_mestre_inicia(&mestre, PAREDE_COLUNAS, PAREDE_LINHAS, enviaParede, NULL);
+    absolute_time_t fim = make_timeout_time_ms(PAREDE_DEMO_MS);
+    absolute_time_t proximo = get_absolute_time();
+
+    while (!time_reached(fim)) {
+        int barra = mestre.quadro % largura;
+        for (int y = 0; y < PAREDE_LINHAS * HEIGHT; y++) {
+            for (int x = 0; x < largura; x++) {
+                int distancia = (barra - x + largura) % largura;
+                uint8_t brilho = distancia < 4 ? 128 >> (distancia * 2) : 0;
+                imagem[y][x] = urgb_u32(brilho, (y * brilho) / HEIGHT, brilho / 2);
+            }
+        }
+        parede_mestre_envia_quadro(&mestre, &imagem[0][0], PAREDE_ATRASO_US);
+
+        // Até o próximo quadro, atende a própria placa para exibir no instante combinado
+        proximo = delayed_by_ms(proximo, PAREDE_PERIODO_MS);
+        while (!time_reached(proximo)) {
+            atendeParede();
+        }
+    }
+
+    parede_mestre_relatorio(&mestre);
+    parede_placa_relatorio(&placa_parede);
+}
+
+/**
+ * Laço das placas escravas: só exibem os quadros recebidos do mestre.
+ * O comando 'w' no console (USB) mostra as estatísticas da placa.
+ */
+static void modoPlacaParede() {
+    governador_desempenho();
+    while (1) {
+        atendeParede();
+        int comando = getchar_timeout_us(0);
+        if (comando == 'w') {
+            parede_placa_relatorio(&placa_parede);
+        }
+    }
+}
+#endif
+
 // Função para gerar uma cor principal aleatória
 uint32_t random_color() {
     uint8_t color_index = rand() % 7; // Gera um número de 0 a 6
@@ -600,57 +969,46 @@ void alert() {
 
 // Função para exibir uma contagem regressiva de 5 segundos
 void contagem_regressiva() {
-    uint32_t frames[][NLEDS] = {
-        {   // Dígito 0
-            1, 1, 1, 1, 1,
-            1, 0, 0, 0, 1,
-            1, 0, 0, 0, 1,
-            1, 0, 0, 0, 1,
-            1, 1, 1, 1, 1
-        },
-        {   // Dígito 1
-            0, 0, 1, 0, 0,
-            0, 0, 1, 0, 0,
-            0, 0, 1, 0, 0,
-            0, 0, 1, 0, 0,
-            0, 0, 1, 1, 0
-        },
-        {   // Dígito 2
-            1, 1, 1, 1, 1,
-            1, 0, 0, 0, 0,
-            1, 1, 1, 1, 1,
-            0, 0, 0, 0, 1,
-            1, 1, 1, 1, 1
-        },
-        {   // Dígito 3
-            1, 1, 1, 1, 1,
-            0, 0, 0, 0, 1,
-            1, 1, 1, 1, 0,
-            0, 0, 0, 0, 1,
-            1, 1, 1, 1, 1
-        },
-        {   // Dígito 4
-            1, 0, 0, 0, 0,
-            0, 0, 0, 0, 1,
-            1, 1, 1, 1, 1,
-            1, 0, 0, 0, 1,
-            1, 0, 0, 0, 1
-        },
-        {   // Dígito 5 
-            1, 1, 1, 1, 1,
-            0, 0, 0, 0, 1,
-            1, 1, 1, 1, 1,
-            1, 0, 0, 0, 0,
-            1, 1, 1, 1, 1
-        },
+    // Dígitos de 0 a 5 como bitboards, desenhados de cima para baixo
+    const bitboard_t digitos[] = {
+        BB_LINHAS(0b11111,  // Dígito 0
+                  0b10001,
+                  0b10001,
+                  0b10001,
+                  0b11111),
+        BB_LINHAS(0b01100,  // Dígito 1
+                  0b00100,
+                  0b00100,
+                  0b00100,
+                  0b00100),
+        BB_LINHAS(0b11111,  // Dígito 2
+                  0b00001,
+                  0b11111,
+                  0b10000,
+                  0b11111),
+        BB_LINHAS(0b11111,  // Dígito 3
+                  0b00001,
+                  0b01111,
+                  0b00001,
+                  0b11111),
+        BB_LINHAS(0b10001,  // Dígito 4
+                  0b10001,
+                  0b11111,
+                  0b00001,
+                  0b00001),
+        BB_LINHAS(0b11111,  // Dígito 5
+                  0b10000,
+                  0b11111,
+                  0b00001,
+                  0b11111),
     };
 
-    // Exibe cada frame do dígito 5 até 0 com uma cor principal e um som aleatório
-    for (size_t i = sizeof(frames) / sizeof(frames[0]) - 1; i + 1; i--)
+    // Exibe cada dígito do 5 até o 0 com uma cor principal e um som aleatório
+    for (size_t i = sizeof(digitos) / sizeof(digitos[0]) - 1; i + 1; i--)
     {
-        uint32_t color = random_color();
-        for (size_t j = 0; j < NLEDS; j++) if(frames[i][j]) frames[i][j] = color;
-        setLEDS(frames[i]);
+        memset(fitaEd, 0, sizeof(fitaEd));
+        bb_pinta(digitos[i], random_color(), fitaEd);
+        atualizaFita();
         emiteSom(500, (rand() % 4000) + 100);
         sleep_ms(500);
     }
@@ -661,23 +1019,117 @@ void contagem_regressiva() {
     apagaLEDS();
 }
 
+/**
+ * Jogo da Vida de Conway em uma matriz toroidal, a partir de um padrão
+ * aleatório. Termina quando a população some, fica estável ou após 100 gerações.
+ */
+void jogoDaVida() {
+    bitboard_t celulas = (rand() ^ ((uint32_t)rand() << 15)) & BB_TUDO;
+    bitboard_t anterior = 0;
+    uint32_t cor = random_color();
+
+    for (int geracao = 0; geracao < 100 && celulas && celulas != anterior; geracao++) {
+        memset(fitaEd, 0, sizeof(fitaEd));
+        bb_pinta(celulas, cor, fitaEd);
+        atualizaFita();
+        sleep_ms(300);
+
+        anterior = celulas;
+        celulas = bb_passo(celulas, BB_REGRA_VIDA, true);
+    }
+    printf("Jogo da Vida: %u celulas vivas no fim\n", bb_conta(celulas));
+    apagaLEDS();
+}
+
+// Trata os comandos recebidos pelo console (stdio)
+void trataComando(int comando) {
+    switch (comando) {
+        case 'm':
+            memoria_relatorio();
+            break;
+        case 'j':
+            jogoCobra();
+            break;
+        case 'v':
+            jogoDaVida();
+            break;
+        case 'c':
+            printf("clk_sys: %lu kHz\n", (unsigned long)governador_khz());
+            break;
+        case 'p':
+            gerenciador_relatorio();
+            break;
+        case 'h':
+            alternaPulso();
+            break;
+        case 'k':
+            alternaTecladoPIO();
+            break;
+        case 'w':
+#if PAREDE_HABILITADA
+            demoParede();
+#else
+            printf("Parede de LEDs desabilitada na compilacao (PAREDE=OFF)\n");
+#endif
+            break;
+        case 't':
+#if TRACE_HABILITADO
+            trace_exporta();
+#else
+            printf("Rastreamento desabilitado na compilacao (TRACE=OFF)\n");
+#endif
+            break;
+        default:
+            break;
+    }
+}
+
 int main() {
+    memoria_pinta_pilha();
     stdio_init_all();
 
-    pio = pio0;
-    sm = 0;
     dma_chan = dma_claim_unused_channel(true);
-    uint offset = pio_add_program(pio, &ws2812_program);
-    ws2812_program_init(pio, sm, offset, PIN_TX, 800000, false);
+    if (!gerenciador_aloca(&ws2812_program, "ws2812", &fita_pio)) {
+        panic("Sem PIO livre para o WS2812");
+    }
+    pio = fita_pio.pio;
+    sm = fita_pio.sm;
+    ws2812_program_init(pio, sm, fita_pio.offset, PIN_TX, 800000, false);
+
+    // O governador mantém o WS2812 em 800 kHz * 10 ciclos por bit a cada troca do clk_sys
+    governador_inicia(aguardaFitaOciosa);
+    governador_registra_sm(pio, sm, 800000.0f * (ws2812_T1 + ws2812_T2 + ws2812_T3));
+
+#if TRACE_HABILITADO
+    // A interrupção de fim do DMA marca no rastreamento quando cada quadro terminou de sair
+    dma_channel_set_irq0_enabled(dma_chan, true);
+    irq_add_shared_handler(DMA_IRQ_0, fimDMA, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+#endif
 
     apagaLEDS();
     init_gpio();
+    iniciaTecladoPIO();  // Sem máquina de estado livre, a varredura continua pela CPU
+
+#if PAREDE_HABILITADA
+    iniciaParede();
+    if (PAREDE_ID != 0) {
+        modoPlacaParede();
+    }
+#endif
+    absolute_time_t ocioso = make_timeout_time_ms(GOVERNADOR_OCIOSO_MS);
 
     while (1) {
+        int comando = getchar_timeout_us(0);
+        if (comando != PICO_ERROR_TIMEOUT) {
+            trataComando(comando);
+        }
+
         char key = scan_keypad();
 
         if (key) {
             printf("Tecla pressionada: %c\n", key);
+            governador_desempenho();  // Sobe o clock enquanto o efeito é desenhado
             switch (key) {
                 case 'A':
                     apagaLEDS();  // Apaga LEDs
@@ -735,7 +1187,12 @@ int main() {
                     break;
             }
 
+            TRACE(TRACE_ESPERA, TRACE_INICIO, 200);
             sleep_ms(200);
+            TRACE(TRACE_ESPERA, TRACE_FIM, 200);
+            ocioso = make_timeout_time_ms(GOVERNADOR_OCIOSO_MS);
+        } else if (time_reached(ocioso)) {
+            governador_economia();  // Sem teclas por um tempo: baixa o clock
         }
 
         sleep_ms(50);
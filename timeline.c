@@ -0,0 +1,125 @@
+#include <string.h>  // memset, usado para zerar o acumulador de cobertura e a pose vazia
+#include "timeline.h"
+
+// Interpola linearmente entre a e b com fração Q15 (a diferença cabe em 16 bits)
+static inline int32_t interpola(int32_t a, int32_t b, int32_t e) {
+    return a + (((b - a) * e) / SUAVE_UM);
+}
+
+uint32_t timeline_duracao_ms(const timeline_t *tl) {
+    return tl->num_chaves ? tl->chaves[tl->num_chaves - 1].t_ms : 0;
+}
+
+int32_t timeline_suaviza(uint8_t curva, int32_t u) {
+    int32_t v;
+
+    if (u <= 0) return 0;
+    if (u >= SUAVE_UM) return SUAVE_UM;
+
+    switch (curva) {
+        case SUAVE_ENTRADA_QUAD:
+            return (u * u) >> 15;
+        case SUAVE_SAIDA_QUAD:
+            v = SUAVE_UM - u;
+            return SUAVE_UM - ((v * v) >> 15);
+        case SUAVE_ENTRADA_SAIDA_QUAD:
+            if (u < SUAVE_UM / 2) return (u * u) >> 14;
+            v = SUAVE_UM - u;
+            return SUAVE_UM - ((v * v) >> 14);
+        case SUAVE_ENTRADA_SAIDA_CUBICA:
+            if (u < SUAVE_UM / 2) return (((u * u) >> 15) * u) >> 13;
+            v = SUAVE_UM - u;
+            return SUAVE_UM - ((((v * v) >> 15) * v) >> 13);
+        case SUAVE_DEGRAU:
+            return 0;
+        case SUAVE_LINEAR:
+        default:
+            return u;
+    }
+}
+
+void timeline_amostra(const timeline_t *tl, uint32_t t_ms, quadro_chave_t *pose) {
+    const quadro_chave_t *a, *b;
+    uint8_t k = 1;
+
+    // Sem quadros-chave não há pose: devolve o sprite apagado
+    if (!tl->num_chaves) {
+        memset(pose, 0, sizeof(*pose));
+        return;
+    }
+    a = &tl->chaves[0];
+
+    // Antes do primeiro ou depois do último quadro-chave a pose fica congelada
+    if (tl->num_chaves < 2 || t_ms <= a->t_ms) {
+        *pose = *a;
+        return;
+    }
+    while (k < tl->num_chaves && tl->chaves[k].t_ms <= t_ms) k++;
+    if (k == tl->num_chaves) {
+        *pose = tl->chaves[k - 1];
+        return;
+    }
+
+    a = &tl->chaves[k - 1];
+    b = &tl->chaves[k];
+
+    // Fração do trecho já percorrida (Q15), passada pela curva do quadro de destino
+    int32_t u = (int32_t)(((t_ms - a->t_ms) * SUAVE_UM) / (b->t_ms - a->t_ms));
+    int32_t e = timeline_suaviza(b->suavizacao, u);
+
+    pose->t_ms = t_ms;
+    pose->x = interpola(a->x, b->x, e);
+    pose->y = interpola(a->y, b->y, e);
+    pose->r = interpola(a->r, b->r, e);
+    pose->g = interpola(a->g, b->g, e);
+    pose->b = interpola(a->b, b->b, e);
+    pose->brilho = interpola(a->brilho, b->brilho, e);
+    pose->suavizacao = b->suavizacao;
+}
+
+void timeline_renderiza(const timeline_t *tl, uint32_t t_ms, uint32_t fita[NLEDS]) {
+    quadro_chave_t pose;
+    uint16_t cobertura[NLEDS];
+
+    memset(fita, 0, NLEDS * sizeof(uint32_t));
+    if (!tl->num_chaves) return;
+
+    timeline_amostra(tl, t_ms, &pose);
+    memset(cobertura, 0, sizeof(cobertura));
+
+    // Parte inteira e fração (0 a 255) do deslocamento
+    int ix = pose.x >> 8, iy = pose.y >> 8;
+    int fx = pose.x & 0xFF, fy = pose.y & 0xFF;
+
+    // Cada pixel do sprite é espalhado nos 4 vizinhos proporcionalmente à fração
+    for (int sy = 0; sy < HEIGHT; sy++) {
+        for (int sx = 0; sx < WIDTH; sx++) {
+            if (!(tl->forma & (1u << (sy * WIDTH + sx)))) continue;
+
+            for (int dy = 0; dy <= 1; dy++) {
+                int ty = sy + iy + dy;
+                int wy = dy ? fy : 256 - fy;
+                if (ty < 0 || ty >= HEIGHT || !wy) continue;
+
+                for (int dx = 0; dx <= 1; dx++) {
+                    int tx = sx + ix + dx;
+                    int wx = dx ? fx : 256 - fx;
+                    if (tx < 0 || tx >= WIDTH || !wx) continue;
+
+                    uint8_t i = indiceLED(tx, ty);
+                    cobertura[i] += (wx * wy) >> 8;
+                    if (cobertura[i] > 256) cobertura[i] = 256;
+                }
+            }
+        }
+    }
+
+    // Converte a cobertura (0 a 256) e o brilho (0 a 255) em intensidade de cada canal
+    for (int i = 0; i < NLEDS; i++) {
+        uint32_t n = cobertura[i] * pose.brilho;
+        if (!n) continue;
+        fita[i] = urgb_u32((pose.r * n) / (256 * 255),
+                           (pose.g * n) / (256 * 255),
+                           (pose.b * n) / (256 * 255));
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <stdint.h>
+#include "matriz.h"
+
+// Valor "1,0" das curvas de suavização, em ponto fixo Q15
+#define SUAVE_UM 32768
+
+// Converte um número inteiro de pixels em posição Q8.8
+#define PIXELS(n) ((int16_t)((n) * 256))
+
+// Curvas de suavização aplicadas entre dois quadros-chave
+typedef enum {
+    SUAVE_LINEAR,
+    SUAVE_ENTRADA_QUAD,         // Começa devagar e acelera
+    SUAVE_SAIDA_QUAD,           // Começa rápido e desacelera
+    SUAVE_ENTRADA_SAIDA_QUAD,   // Acelera e desacelera
+    SUAVE_ENTRADA_SAIDA_CUBICA, // Como a anterior, porém mais acentuada
+    SUAVE_DEGRAU                // Mantém o quadro anterior até o próximo
+} suavizacao_t;
+
+/**
+ * Pose de um sprite em um instante da animação.
+ *
+ * t_ms = Instante do quadro-chave, contado a partir do início da animação.
+ * x, y = Deslocamento do sprite em pixels, no formato Q8.8 (y cresce para cima).
+ * r, g, b = Cor do sprite.
+ * brilho = Intensidade global do sprite (0 a 255).
+ * suavizacao = Curva usada no trecho que termina neste quadro-chave.
+ */
+typedef struct {
+    uint16_t t_ms;
+    int16_t x, y;
+    uint8_t r, g, b;
+    uint8_t brilho;
+    uint8_t suavizacao;
+} quadro_chave_t;
+
+/**
+ * Linha do tempo: um sprite monocromático e a lista de poses que ele assume.
+ * O bit (y * WIDTH + x) de 'forma' indica se o pixel (x, y) do sprite está aceso.
+ */
+typedef struct {
+    uint32_t forma;
+    const quadro_chave_t *chaves;
+    uint8_t num_chaves;
+} timeline_t;
+
+// Duração total da linha do tempo (instante do último quadro-chave)
+uint32_t timeline_duracao_ms(const timeline_t *tl);
+
+// Aplica a curva de suavização a uma fração de tempo Q15 (0 a SUAVE_UM)
+int32_t timeline_suaviza(uint8_t curva, int32_t u);
+
+// Calcula a pose interpolada no instante t_ms (zerada se não houver quadros-chave)
+void timeline_amostra(const timeline_t *tl, uint32_t t_ms, quadro_chave_t *pose);
+
+// Desenha o sprite no instante t_ms, com posição em subpixel, no buffer da fita
+void timeline_renderiza(const timeline_t *tl, uint32_t t_ms, uint32_t fita[NLEDS]);
+
+#endif
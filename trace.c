@@ -0,0 +1,112 @@
+#include <stdio.h>  // printf, usado na exportação em JSON
+#include "pico/stdlib.h"  // time_us_32, relógio de microssegundos (no dispositivo e no host)
+#include "trace.h"
+
+#if TRACE_HABILITADO
+
+/**
+ * Anel de registros com um único produtor. O produtor grava o registro e só
+ * depois avança 'escrita', então o leitor nunca vê um registro pela metade e
+ * nenhum dos lados precisa desabilitar interrupções.
+ */
+typedef struct {
+    trace_registro_t *registros;
+    uint32_t mascara;
+    volatile uint32_t escrita;  // Total de registros já gravados
+    uint32_t leitura;           // Total de registros já exportados ou descartados
+} anel_t;
+
+static trace_registro_t registros_principal[TRACE_TAM_PRINCIPAL];
+static trace_registro_t registros_irq[TRACE_TAM_IRQ];
+
+// Anel 0: código principal do core0; anel 1: tratadores de interrupção
+static anel_t aneis[2] = {
+    { registros_principal, TRACE_TAM_PRINCIPAL - 1, 0, 0 },
+    { registros_irq, TRACE_TAM_IRQ - 1, 0, 0 },
+};
+
+static const char *const nomes[TRACE_NUM_EVENTOS] = {
+    "tecla", "quadro", "dma", "som", "espera"
+};
+
+// Linha do visualizador em que cada evento aparece (0 = core0, 1 = DMA)
+static const uint8_t linhas[TRACE_NUM_EVENTOS] = { 0, 0, 1, 0, 0 };
+
+// Cada contexto grava apenas no seu anel, o que mantém um produtor por anel
+static inline anel_t *anelAtual(void) {
+#if PICO_ON_DEVICE
+    return &aneis[__get_current_exception() ? 1 : 0];
+#else
+    return &aneis[0];
+#endif
+}
+
+void trace_registra(uint8_t evento, uint8_t fase, uint16_t arg) {
+    anel_t *anel = anelAtual();
+    uint32_t n = anel->escrita;
+    trace_registro_t *r = &anel->registros[n & anel->mascara];
+
+    r->t_us = time_us_32();
+    r->evento = evento;
+    r->fase = fase;
+    r->arg = arg;
+
+    // Publica o registro somente depois de completamente gravado
+    __asm volatile ("" ::: "memory");
+    anel->escrita = n + 1;
+}
+
+// Primeiro registro ainda disponível: os mais antigos podem ter sido sobrescritos
+static uint32_t inicioAnel(const anel_t *anel, uint32_t fim) {
+    uint32_t capacidade = anel->mascara + 1;
+    return (fim - anel->leitura > capacidade) ? fim - capacidade : anel->leitura;
+}
+
+// Cada registro vem depois dos metadados, por isso sempre começa com vírgula
+static void imprimeRegistro(const trace_registro_t *r) {
+    printf(",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%lu,\"pid\":1,\"tid\":%u,\"args\":{\"arg\":%u}%s}",
+           r->evento < TRACE_NUM_EVENTOS ? nomes[r->evento] : "?",
+           r->fase, (unsigned long)r->t_us,
+           r->evento < TRACE_NUM_EVENTOS ? linhas[r->evento] : 0,
+           r->arg,
+           r->fase == TRACE_INSTANTE ? ",\"s\":\"t\"" : "");
+}
+
+void trace_exporta(void) {
+    uint32_t fim[2], i[2];
+
+    for (int a = 0; a < 2; a++) {
+        fim[a] = aneis[a].escrita;
+        i[a] = inicioAnel(&aneis[a], fim[a]);
+    }
+
+    printf("{\"traceEvents\":[\n");
+    printf("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"core0\"}},\n");
+    printf("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"dma\"}}");
+
+    // Intercala os dois anéis em ordem de tempo (a diferença com sinal tolera o estouro do contador)
+    while (i[0] != fim[0] || i[1] != fim[1]) {
+        const trace_registro_t *r0 = (i[0] != fim[0]) ? &aneis[0].registros[i[0] & aneis[0].mascara] : NULL;
+        const trace_registro_t *r1 = (i[1] != fim[1]) ? &aneis[1].registros[i[1] & aneis[1].mascara] : NULL;
+
+        if (r1 == NULL || (r0 != NULL && (int32_t)(r0->t_us - r1->t_us) <= 0)) {
+            imprimeRegistro(r0);
+            i[0]++;
+        } else {
+            imprimeRegistro(r1);
+            i[1]++;
+        }
+    }
+
+    printf("\n],\"displayTimeUnit\":\"ms\"}\n");
+
+    aneis[0].leitura = fim[0];
+    aneis[1].leitura = fim[1];
+}
+
+void trace_limpa(void) {
+    aneis[0].leitura = aneis[0].escrita;
+    aneis[1].leitura = aneis[1].escrita;
+}
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+// Com TRACE_HABILITADO = 0 todos os pontos de rastreamento somem do código gerado
+#ifndef TRACE_HABILITADO
+#define TRACE_HABILITADO 1
+#endif
+
+// Capacidade de cada anel (potência de 2): um para o código principal e outro para interrupções
+#define TRACE_TAM_PRINCIPAL 1024
+#define TRACE_TAM_IRQ 128
+
+// Eventos rastreados; cada um aparece com seu nome no visualizador
+typedef enum {
+    TRACE_TECLA,   // Tecla pressionada, registrada uma vez por toque em scan_keypad (arg = tecla)
+    TRACE_QUADRO,  // Envio de um quadro em atualizaFita
+    TRACE_DMA,     // Transferência DMA da fita, do disparo até a interrupção de fim
+    TRACE_SOM,     // Tom emitido por emiteSom (arg = frequência)
+    TRACE_ESPERA,  // Espera entre quadros ou após uma tecla (arg = ms)
+    TRACE_NUM_EVENTOS
+} trace_evento_t;
+
+// Fases no formato do Chrome trace: início, fim ou evento instantâneo
+typedef enum {
+    TRACE_INICIO = 'B',
+    TRACE_FIM = 'E',
+    TRACE_INSTANTE = 'i'
+} trace_fase_t;
+
+/**
+ * Registro de um evento.
+ *
+ * t_us = Instante em microssegundos, lido do temporizador do RP2040.
+ * evento = Um dos valores de trace_evento_t.
+ * fase = Um dos valores de trace_fase_t.
+ * arg = Informação extra do evento (tecla, frequência, duração...).
+ */
+typedef struct {
+    uint32_t t_us;
+    uint8_t evento;
+    uint8_t fase;
+    uint16_t arg;
+} trace_registro_t;
+
+#if TRACE_HABILITADO
+#define TRACE(evento, fase, arg) trace_registra((evento), (fase), (arg))
+#else
+#define TRACE(evento, fase, arg) ((void)0)
+#endif
+
+// Grava um evento no anel do contexto atual, sobrescrevendo o mais antigo se estiver cheio
+void trace_registra(uint8_t evento, uint8_t fase, uint16_t arg);
+
+// Imprime os eventos guardados no formato JSON do Chrome trace/Perfetto e esvazia os anéis
+void trace_exporta(void);
+
+// Descarta todos os eventos guardados
+void trace_limpa(void);
+
+#endif